@@ -0,0 +1,37 @@
+// Contador de reservas de memoria dinamica, para los benchmarks que
+// comparan cuantas reservas hace cada version (medirBuilders,
+// medirIteracion, ...). Reemplaza operator new/delete de todo el programa,
+// asi que se incluye en un solo .cpp por ejecutable y solo en las clases
+// que lo usan.
+
+#ifndef CONTADOR_ASIGNACIONES_H
+#define CONTADOR_ASIGNACIONES_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>   // malloc y free
+#include <new>
+
+// Cantidad de llamadas a operator new desde que empezo el programa
+inline std::atomic<std::size_t> asignaciones{0};
+
+void* operator new(std::size_t tam) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(tam))
+        return p;
+    throw std::bad_alloc();
+}
+
+// La version nothrow tambien se reemplaza: si no, reservaria con el
+// operator new original y liberaria con el delete de abajo
+void* operator new(std::size_t tam, const std::nothrow_t&) noexcept {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(tam);
+}
+
+// noinline: si GCC ve el free() dentro de quien llamo a new, avisa (en
+// falso) de que new y free no se corresponden
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#endif
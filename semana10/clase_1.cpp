@@ -2,6 +2,33 @@
 
 #include <iostream>
 #include <vector>
+#include <string_view>
+#include <cstring>   // memcpy
+#include <charconv>  // to_chars
+#include <chrono>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+#include <random>
+#include <bit>       // countr_zero
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <cmath>     // isfinite
+#include <cerrno>
+#include <fcntl.h>   // open
+#include <unistd.h>  // write y close
+#include <sys/resource.h>  // getrusage (memoria maxima)
+#if defined(__SSE2__)
+#include <emmintrin.h> // SSE2 (comparar 4 codigos de 32 bits a la vez)
+#endif
+#include "../comun/contador_asignaciones.h"   // asignaciones (para medirBuilders)
 using namespace std;
 
 // Ejemplo 1: Miembros estaticos y Singleton
@@ -147,8 +174,54 @@ public:
     }
 };
 
+// Validaciones del texto de una consulta (constexpr: ConsultaFija las hace
+// al compilar y SQLQueryBuilder al armarla)
+constexpr bool esIdentificador(string_view s) {
+    if (s.empty())
+        return false;
+    for (char c : s) {
+        bool valido = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                      (c >= '0' && c <= '9') || c == '_' || c == '.';
+        if (!valido)
+            return false;
+    }
+    return true;
+}
+
+// Compara sin distinguir mayusculas (las palabras clave de SQL no las distinguen)
+constexpr bool igualSinMayusculas(string_view a, string_view b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        char x = (a[i] >= 'a' && a[i] <= 'z') ? (char)(a[i] - 'a' + 'A') : a[i];
+        char y = (b[i] >= 'a' && b[i] <= 'z') ? (char)(b[i] - 'a' + 'A') : b[i];
+        if (x != y)
+            return false;
+    }
+    return true;
+}
+
+// "columna", "columna ASC" o "columna DESC" (ASC y DESC en cualquier caja)
+constexpr bool esOrden(string_view s) {
+    size_t espacio = 0;
+    while (espacio < s.size() && s[espacio] != ' ')
+        espacio++;
+    if (espacio == s.size())
+        return esIdentificador(s);
+    string_view direccion = s.substr(espacio + 1);
+    return esIdentificador(s.substr(0, espacio)) && (igualSinMayusculas(direccion, "ASC") || igualSinMayusculas(direccion, "DESC"));
+}
+
 // SQLQueryBuilder: Construcción fluida de consultas SQL
 
+// Consulta separada en su "forma" (con ? en lugar de los valores) y los
+// valores que van en cada ?, en orden
+struct ConsultaParametrizada {
+    string forma;
+    size_t hashForma = 0;          // hash de "forma" (se calcula una vez al armarla)
+    vector<string> parametros;
+};
+
 class SQLQueryBuilder {
 private:
     string query;                  // almacena la consulta final
@@ -158,41 +231,82 @@ private:
     string filtro_valor;           // valor para WHERE
     string orden;                  // cláusula ORDER BY
     int limite = -1;               // cláusula LIMIT (-1 = sin límite)
+    ConsultaParametrizada parametrizada;  // ultima forma armada y sus valores
+    bool formaVigente = false;     // false si cambio algo que no es el valor del WHERE
 
 public:
     // Asigna la tabla
     SQLQueryBuilder& setTable(string table) {
         tabla = table;
+        formaVigente = false;
         return *this;              // devuelve referencia para encadenar
     }
 
     // Añade una columna al SELECT
     SQLQueryBuilder& addColumn(string columna) {
         columnas.push_back(columna);
+        formaVigente = false;
         return *this;
     }
 
     // Define clausula WHERE: columna = 'valor'
     SQLQueryBuilder& setWhereClause(string columna, string valor) {
-        filtro_columna = columna;
+        if (columna != filtro_columna) {
+            filtro_columna = columna;
+            formaVigente = false;  // cambiar solo el valor no cambia la forma
+        }
         filtro_valor  = valor;
         return *this;
     }
 
-    // Define clausula ORDER BY
+    // Define clausula ORDER BY ("columna [ASC|DESC]"); rechaza otra direccion
     SQLQueryBuilder& setOrderByClause(string orden) {
+        if (!orden.empty() && !esOrden(orden))
+            throw invalid_argument("ORDER BY invalido (columna [ASC|DESC]): " + orden);
         this->orden = orden;
+        formaVigente = false;
         return *this;
     }
 
     // Define clausula LIMIT
     SQLQueryBuilder& setLimit(int limit) {
         limite = limit;
+        formaVigente = false;
         return *this;
     }
 
+    // Partes de la consulta (para ejecutarla sin pasar por el texto)
+    const string& getTabla() const { return tabla; }
+    const vector<string>& getColumnas() const { return columnas; }
+    const string& getFiltroColumna() const { return filtro_columna; }
+    const string& getFiltroValor() const { return filtro_valor; }
+    const string& getOrden() const { return orden; }
+    int getLimite() const { return limite; }
+
     // Ensambla la consulta y la devuelve
     string build() {
+        return armar(false);
+    }
+
+    // Igual que build() pero con un ? en lugar del valor del WHERE, que va
+    // aparte: las consultas que solo cambian en el valor comparten la forma.
+    // La forma (y su hash) se guarda en el builder y solo se vuelve a armar
+    // si cambio; si no, solo se copian los valores. La referencia vale
+    // mientras viva el builder (con un builder temporal, copiarla)
+    const ConsultaParametrizada& buildParametrizada() {
+        if (!formaVigente) {
+            parametrizada.forma = armar(true);
+            parametrizada.hashForma = hash<string>{}(parametrizada.forma);
+            formaVigente = true;
+        }
+        parametrizada.parametros.resize(filtro_columna.empty() ? 0 : 1);
+        if (!filtro_columna.empty())
+            parametrizada.parametros[0] = filtro_valor;   // reusa la capacidad
+        return parametrizada;
+    }
+
+private:
+    string armar(bool parametrizada) {
         query = "SELECT ";
         // Agrega las columnas separadas por comas
         for (int i = 0; i < (int)columnas.size(); ++i) {
@@ -204,8 +318,11 @@ public:
         query += " FROM " + tabla;
         // Agrega WHERE si se estableció filtro
         if (!filtro_columna.empty()) {
-            query += " WHERE " + filtro_columna
-                   + " = '" + filtro_valor + "'";
+            if (parametrizada)
+                query += " WHERE " + filtro_columna + " = ?";
+            else
+                query += " WHERE " + filtro_columna
+                       + " = '" + filtro_valor + "'";
         }
         // Agrega ORDER BY si corresponde
         if (!orden.empty()) {
@@ -219,6 +336,1006 @@ public:
     }
 };
 
+// Sentencia ya "compilada" por el ejecutor: la forma partida en los trozos
+// de texto que quedan entre los ?
+struct Sentencia {
+    int id;
+    string forma;
+    vector<string> trozos;
+};
+
+// Reemplazo en memoria de la base de datos: preparar() hace el trabajo caro
+// (analizar la forma) y ejecutar() solo completa los ? con los valores
+class EjecutorSimulado {
+private:
+    int compilaciones = 0;
+    int ejecuciones = 0;
+
+public:
+    shared_ptr<const Sentencia> preparar(const string& forma) {
+        auto sentencia = make_shared<Sentencia>();
+        sentencia->id = ++compilaciones;
+        sentencia->forma = forma;
+        size_t desde = 0, pos;
+        while ((pos = forma.find('?', desde)) != string::npos) {
+            sentencia->trozos.push_back(forma.substr(desde, pos - desde));
+            desde = pos + 1;
+        }
+        sentencia->trozos.push_back(forma.substr(desde));
+        return sentencia;
+    }
+
+    // Devuelve el texto que "recibiria" la base (valores entre comillas y
+    // con las comillas internas duplicadas)
+    string ejecutar(const Sentencia& sentencia, const vector<string>& parametros) {
+        if (parametros.size() + 1 != sentencia.trozos.size())
+            throw invalid_argument("cantidad de parametros incorrecta");
+        ejecuciones++;
+        string texto = sentencia.trozos[0];
+        for (size_t i = 0; i < parametros.size(); i++) {
+            texto += '\'';
+            for (char c : parametros[i]) {
+                if (c == '\'')
+                    texto += '\'';
+                texto += c;
+            }
+            texto += '\'';
+            texto += sentencia.trozos[i + 1];
+        }
+        return texto;
+    }
+
+    int getCompilaciones() const { return compilaciones; }
+    int getEjecuciones() const { return ejecuciones; }
+};
+
+// Cache LRU de sentencias preparadas, indexada por la forma de la consulta.
+// Repetir una consulta que solo cambia en los valores cuesta una busqueda
+// en la tabla hash con el hash ya calculado por el builder; si la cache se
+// llena se descarta la menos usada
+class CacheSentencias {
+private:
+    struct Entrada {
+        string forma;
+        size_t hashForma;
+        shared_ptr<const Sentencia> sentencia;
+    };
+
+    // Clave del indice: el hash viene calculado, solo se compara el texto
+    struct ClaveForma {
+        size_t hash;
+        string_view forma;         // apunta a la forma guardada en "usadas"
+        bool operator==(const ClaveForma& otra) const {
+            return hash == otra.hash && forma == otra.forma;
+        }
+    };
+    struct HashClave {
+        size_t operator()(const ClaveForma& clave) const { return clave.hash; }
+    };
+
+    EjecutorSimulado& ejecutor;
+    size_t capacidad;
+    list<Entrada> usadas;                                  // al frente, la mas reciente
+    unordered_map<ClaveForma, list<Entrada>::iterator, HashClave> indice;
+    size_t aciertos = 0;
+    size_t fallos = 0;
+    size_t desalojos = 0;
+
+public:
+    CacheSentencias(EjecutorSimulado& ejecutor, size_t capacidad)
+        : ejecutor(ejecutor), capacidad(max<size_t>(capacidad, 1)) {}
+
+    // Devuelve la sentencia preparada para esta forma (la prepara si no esta)
+    shared_ptr<const Sentencia> obtener(const string& forma) {
+        return obtener(forma, hash<string>{}(forma));
+    }
+
+    // Igual, con el hash de la forma ya calculado (sin recorrer el texto
+    // salvo para confirmar que coincide)
+    shared_ptr<const Sentencia> obtener(const string& forma, size_t hashForma) {
+        auto it = indice.find(ClaveForma{hashForma, forma});
+        if (it != indice.end()) {
+            aciertos++;
+            usadas.splice(usadas.begin(), usadas, it->second);
+            return it->second->sentencia;
+        }
+        fallos++;
+        usadas.push_front(Entrada{forma, hashForma, ejecutor.preparar(forma)});
+        indice.emplace(ClaveForma{hashForma, usadas.front().forma}, usadas.begin());
+        if (usadas.size() > capacidad) {
+            indice.erase(ClaveForma{usadas.back().hashForma, usadas.back().forma});
+            usadas.pop_back();
+            desalojos++;
+        }
+        return usadas.front().sentencia;
+    }
+
+    string ejecutar(const ConsultaParametrizada& consulta) {
+        return ejecutor.ejecutar(*obtener(consulta.forma, consulta.hashForma), consulta.parametros);
+    }
+
+    double tasaAciertos() const {
+        size_t total = aciertos + fallos;
+        return total == 0 ? 0 : (double)aciertos / total;
+    }
+
+    void mostrarEstadisticas() const {
+        cout << "Cache de sentencias: " << aciertos << " aciertos, " << fallos
+             << " fallos, " << desalojos << " desalojos (" << tasaAciertos() * 100
+             << "% de aciertos)" << endl;
+    }
+};
+
+// Columna de una tabla en memoria. Los enteros se guardan tal cual; los
+// textos con diccionario: cada texto distinto se guarda una sola vez y la
+// columna solo guarda su codigo (comparar codigos es comparar enteros)
+struct Columna {
+    string nombre;
+    bool esTexto;
+    vector<int64_t> enteros;
+    vector<uint32_t> codigos;
+    vector<string> diccionario;                 // codigo -> texto
+    unordered_map<string, uint32_t> codigoDe;   // texto -> codigo
+    mutable vector<uint32_t> rango;             // codigo -> lugar en orden alfabetico
+                                                // (se calcula al ordenar, vacio = no calculado)
+
+    string valor(size_t fila) const {
+        return esTexto ? diccionario[codigos[fila]] : to_string(enteros[fila]);
+    }
+};
+
+// Filas que devuelve una consulta (solo las columnas pedidas)
+struct ResultadoConsulta {
+    vector<string> columnas;
+    vector<vector<string>> filas;
+
+    void mostrar() const {
+        for (int i = 0; i < (int)columnas.size(); i++)
+            cout << (i ? " | " : "") << columnas[i];
+        cout << endl;
+        for (const vector<string>& fila : filas) {
+            for (int i = 0; i < (int)fila.size(); i++)
+                cout << (i ? " | " : "") << fila[i];
+            cout << endl;
+        }
+    }
+};
+
+// Tabla guardada por columnas (cada columna es un vector contiguo)
+class TablaColumnar {
+private:
+    vector<Columna> columnas;
+    size_t filas = 0;
+
+public:
+    // "esquema": nombre de cada columna y si es de texto (si no, es entera)
+    TablaColumnar(const vector<pair<string, bool>>& esquema) {
+        for (const auto& [nombre, esTexto] : esquema) {
+            Columna c;
+            c.nombre = nombre;
+            c.esTexto = esTexto;
+            columnas.push_back(std::move(c));
+        }
+    }
+
+    // Agrega una fila con un valor (en texto) por columna
+    void agregarFila(const vector<string>& valores) {
+        if (valores.size() != columnas.size())
+            throw invalid_argument("la fila no tiene un valor por columna");
+        for (size_t i = 0; i < columnas.size(); i++) {
+            Columna& c = columnas[i];
+            if (c.esTexto) {
+                auto [it, nuevo] = c.codigoDe.try_emplace(valores[i], (uint32_t)c.diccionario.size());
+                if (nuevo) {
+                    c.diccionario.push_back(valores[i]);
+                    c.rango.clear();
+                }
+                c.codigos.push_back(it->second);
+            } else {
+                int64_t numero;
+                const string& v = valores[i];
+                auto [fin, error] = from_chars(v.data(), v.data() + v.size(), numero);
+                if (error != errc() || fin != v.data() + v.size())
+                    throw invalid_argument("valor no entero en la columna " + c.nombre);
+                c.enteros.push_back(numero);
+            }
+        }
+        filas++;
+    }
+
+    const Columna& columna(const string& nombre) const {
+        for (const Columna& c : columnas)
+            if (c.nombre == nombre)
+                return c;
+        throw invalid_argument("columna desconocida: " + nombre);
+    }
+
+    // Lugar de cada codigo de una columna de texto en orden alfabetico; se
+    // calcula una vez y se reutiliza hasta que aparezca un texto nuevo
+    const vector<uint32_t>& rangos(const string& nombre) const {
+        const Columna& c = columna(nombre);
+        if (c.rango.size() != c.diccionario.size()) {
+            vector<uint32_t> porTexto(c.diccionario.size());
+            for (size_t i = 0; i < porTexto.size(); i++)
+                porTexto[i] = (uint32_t)i;
+            sort(porTexto.begin(), porTexto.end(), [&c](uint32_t a, uint32_t b) {
+                return c.diccionario[a] < c.diccionario[b];
+            });
+            c.rango.resize(porTexto.size());
+            for (size_t i = 0; i < porTexto.size(); i++)
+                c.rango[porTexto[i]] = (uint32_t)i;
+        }
+        return c.rango;
+    }
+
+    const vector<Columna>& getColumnas() const { return columnas; }
+    size_t size() const { return filas; }
+};
+
+// Ejecuta las consultas de SQLQueryBuilder sobre tablas en memoria
+class BaseEnMemoria {
+private:
+    unordered_map<string, TablaColumnar> tablas;
+    size_t filasRevisadas = 0;
+
+    // Agrega a "filas" las posiciones donde codigos[i] == buscado
+    static void filtrarCodigos(const uint32_t* codigos, size_t n, uint32_t buscado,
+                               vector<uint32_t>& filas) {
+        size_t i = 0;
+#if defined(__SSE2__)
+        // 16 codigos por vuelta: 4 comparaciones de 4 enteros de 32 bits
+        __m128i objetivo = _mm_set1_epi32((int)buscado);
+        for (; i + 16 <= n; i += 16) {
+            unsigned mascara = 0;
+            for (int k = 0; k < 4; k++) {
+                __m128i bloque = _mm_loadu_si128((const __m128i*)(codigos + i + 4 * k));
+                __m128i iguales = _mm_cmpeq_epi32(bloque, objetivo);
+                mascara |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(iguales)) << (4 * k);
+            }
+            while (mascara != 0) {
+                filas.push_back((uint32_t)(i + countr_zero(mascara)));
+                mascara &= mascara - 1;
+            }
+        }
+#endif
+        for (; i < n; i++)
+            if (codigos[i] == buscado)
+                filas.push_back((uint32_t)i);
+    }
+
+    // Igual para columnas enteras (sin saltos, el compilador lo vectoriza)
+    static void filtrarEnteros(const int64_t* valores, size_t n, int64_t buscado,
+                               vector<uint32_t>& filas) {
+        filas.resize(n);
+        size_t cuantas = 0;
+        for (size_t i = 0; i < n; i++) {
+            filas[cuantas] = (uint32_t)i;
+            cuantas += valores[i] == buscado;
+        }
+        filas.resize(cuantas);
+    }
+
+public:
+    TablaColumnar& crearTabla(const string& nombre, const vector<pair<string, bool>>& esquema) {
+        return tablas.insert_or_assign(nombre, TablaColumnar(esquema)).first->second;
+    }
+
+    ResultadoConsulta ejecutar(const SQLQueryBuilder& consulta) {
+        auto it = tablas.find(consulta.getTabla());
+        if (it == tablas.end())
+            throw invalid_argument("tabla desconocida: " + consulta.getTabla());
+        const TablaColumnar& tabla = it->second;
+
+        // WHERE: solo se recorre la columna del filtro
+        vector<uint32_t> filas;
+        if (!consulta.getFiltroColumna().empty()) {
+            const Columna& c = tabla.columna(consulta.getFiltroColumna());
+            const string& valor = consulta.getFiltroValor();
+            if (c.esTexto) {
+                auto codigo = c.codigoDe.find(valor);
+                if (codigo != c.codigoDe.end()) {  // si el texto no existe no hay filas
+                    filtrarCodigos(c.codigos.data(), tabla.size(), codigo->second, filas);
+                    filasRevisadas += tabla.size();
+                }
+            } else {
+                int64_t numero;
+                auto [fin, error] = from_chars(valor.data(), valor.data() + valor.size(), numero);
+                if (error == errc() && fin == valor.data() + valor.size()) {
+                    filtrarEnteros(c.enteros.data(), tabla.size(), numero, filas);
+                    filasRevisadas += tabla.size();
+                }
+            }
+        } else {
+            filas.resize(tabla.size());
+            for (size_t i = 0; i < filas.size(); i++)
+                filas[i] = (uint32_t)i;
+        }
+
+        // ORDER BY "columna [ASC|DESC]"; con LIMIT solo se ordenan las primeras
+        size_t limite = consulta.getLimite() >= 0 ? (size_t)consulta.getLimite() : filas.size();
+        limite = min(limite, filas.size());
+        if (!consulta.getOrden().empty()) {
+            string orden = consulta.getOrden();
+            bool descendente = false;
+            size_t espacio = orden.find(' ');
+            if (espacio != string::npos) {
+                string_view direccion = string_view(orden).substr(espacio + 1);
+                if (!esOrden(orden))
+                    throw invalid_argument("ORDER BY invalido (columna [ASC|DESC]): " + orden);
+                descendente = igualSinMayusculas(direccion, "DESC");
+                orden = orden.substr(0, espacio);
+            }
+            const Columna& c = tabla.columna(orden);
+            // Los textos se comparan por su lugar en el diccionario ordenado
+            const vector<uint32_t>* rango = c.esTexto ? &tabla.rangos(orden) : nullptr;
+            auto valor = [&](uint32_t fila) {
+                return c.esTexto ? (int64_t)(*rango)[c.codigos[fila]] : c.enteros[fila];
+            };
+            auto menor = [&](uint32_t a, uint32_t b) {
+                int64_t va = valor(a), vb = valor(b);
+                if (va != vb)
+                    return descendente ? va > vb : va < vb;
+                return a < b;                  // empates por numero de fila
+            };
+            partial_sort(filas.begin(), filas.begin() + limite, filas.end(), menor);
+        }
+        filas.resize(limite);
+
+        // Solo se materializan las columnas pedidas (sin columnas = todas)
+        vector<const Columna*> elegidas;
+        for (const string& nombre : consulta.getColumnas())
+            elegidas.push_back(&tabla.columna(nombre));
+        if (elegidas.empty())
+            for (const Columna& c : tabla.getColumnas())
+                elegidas.push_back(&c);
+
+        ResultadoConsulta resultado;
+        for (const Columna* c : elegidas)
+            resultado.columnas.push_back(c->nombre);
+        for (uint32_t fila : filas) {
+            vector<string> valores;
+            for (const Columna* c : elegidas)
+                valores.push_back(c->valor(fila));
+            resultado.filas.push_back(std::move(valores));
+        }
+        return resultado;
+    }
+
+    size_t getFilasRevisadas() const { return filasRevisadas; }
+};
+
+// Mide cuantas filas por segundo revisa el motor con una tabla "empleados"
+// de "n" filas y un WHERE sobre texto y otro sobre enteros
+void medirMotor(int n) {
+    BaseEnMemoria base;
+    TablaColumnar& empleados = base.crearTabla("empleados",
+        {{"id", false}, {"nombre", true}, {"posicion", true}, {"salario", false}});
+    vector<string> puestos = {"Analista", "Gerente", "Desarrollador", "Soporte", "Ventas"};
+    mt19937 gen(3);
+    for (int i = 0; i < n; i++)
+        empleados.agregarFila({to_string(i), "Empleado_" + to_string(i),
+                               puestos[gen() % puestos.size()], to_string(1000 + gen() % 9000)});
+
+    SQLQueryBuilder porTexto;
+    porTexto.setTable("empleados").addColumn("id").addColumn("nombre")
+            .setWhereClause("posicion", "Analista").setOrderByClause("salario DESC").setLimit(10);
+    SQLQueryBuilder porEntero;
+    porEntero.setTable("empleados").addColumn("nombre")
+             .setWhereClause("salario", "5000").setOrderByClause("nombre ASC").setLimit(10);
+
+    for (SQLQueryBuilder* consulta : {&porTexto, &porEntero}) {
+        base.ejecutar(*consulta);   // la primera vez calcula el orden de los textos
+        size_t antes = base.getFilasRevisadas();
+        auto t0 = chrono::steady_clock::now();
+        for (int vuelta = 0; vuelta < 20; vuelta++)
+            base.ejecutar(*consulta);
+        auto t1 = chrono::steady_clock::now();
+        cout << consulta->build() << ": "
+             << (base.getFilasRevisadas() - antes) / chrono::duration<double>(t1 - t0).count()
+             << " filas/s" << endl;
+    }
+}
+
+// Variante de SQLQueryBuilder que no reserva memoria al armar la consulta:
+// guarda vistas (string_view) a los textos que recibe, calcula primero el
+// largo exacto y escribe la consulta de una sola pasada en un buffer dado
+// por quien llama. Los textos tienen que seguir vivos hasta build().
+class SQLQueryBuilderVista {
+private:
+    string_view tabla;
+    vector<string_view> columnas;  // se reutiliza entre consultas (clear no libera)
+    string_view filtro_columna;
+    string_view filtro_valor;
+    string_view orden;
+    int limite = -1;
+
+    static char* copiar(char* destino, string_view texto) {
+        memcpy(destino, texto.data(), texto.size());
+        return destino + texto.size();
+    }
+
+    static size_t digitos(int n) {
+        size_t cuantos = 1;
+        while (n >= 10) {
+            n /= 10;
+            cuantos++;
+        }
+        return cuantos;
+    }
+
+public:
+    SQLQueryBuilderVista& setTable(string_view table) {
+        tabla = table;
+        return *this;
+    }
+
+    SQLQueryBuilderVista& addColumn(string_view columna) {
+        columnas.push_back(columna);
+        return *this;
+    }
+
+    SQLQueryBuilderVista& setWhereClause(string_view columna, string_view valor) {
+        filtro_columna = columna;
+        filtro_valor = valor;
+        return *this;
+    }
+
+    SQLQueryBuilderVista& setOrderByClause(string_view orden) {
+        this->orden = orden;
+        return *this;
+    }
+
+    SQLQueryBuilderVista& setLimit(int limit) {
+        limite = limit;
+        return *this;
+    }
+
+    // Deja el builder vacio para otra consulta (sin liberar memoria)
+    SQLQueryBuilderVista& reset() {
+        tabla = filtro_columna = filtro_valor = orden = {};
+        columnas.clear();
+        limite = -1;
+        return *this;
+    }
+
+    // Largo exacto de la consulta que arma build()
+    size_t longitud() const {
+        size_t total = 7 + 6 + tabla.size();                  // "SELECT " y " FROM "
+        for (int i = 0; i < (int)columnas.size(); ++i)
+            total += columnas[i].size() + (i > 0 ? 2 : 0);    // ", " entre columnas
+        if (!filtro_columna.empty())
+            total += 7 + filtro_columna.size() + 4 + filtro_valor.size() + 1;
+        if (!orden.empty())
+            total += 10 + orden.size();                       // " ORDER BY "
+        if (limite >= 0)
+            total += 7 + digitos(limite);                     // " LIMIT "
+        return total;
+    }
+
+    // Escribe la consulta en "destino" (sin '\0' al final) y devuelve su largo
+    size_t build(char* destino, size_t capacidad) const {
+        size_t total = longitud();
+        if (total > capacidad)
+            throw length_error("el buffer no alcanza para la consulta");
+        char* p = copiar(destino, "SELECT ");
+        for (int i = 0; i < (int)columnas.size(); ++i) {
+            if (i > 0)
+                p = copiar(p, ", ");
+            p = copiar(p, columnas[i]);
+        }
+        p = copiar(p, " FROM ");
+        p = copiar(p, tabla);
+        if (!filtro_columna.empty()) {
+            p = copiar(p, " WHERE ");
+            p = copiar(p, filtro_columna);
+            p = copiar(p, " = '");
+            p = copiar(p, filtro_valor);
+            *p++ = '\'';
+        }
+        if (!orden.empty()) {
+            p = copiar(p, " ORDER BY ");
+            p = copiar(p, orden);
+        }
+        if (limite >= 0) {
+            p = copiar(p, " LIMIT ");
+            to_chars(p, destino + total, limite);
+        }
+        return total;
+    }
+
+    // Arma la consulta en "buffer"; si se reutiliza el mismo buffer solo
+    // reserva memoria cuando una consulta es mas larga que todas las anteriores
+    string_view build(string& buffer) const {
+        buffer.resize(longitud());
+        build(buffer.data(), buffer.size());
+        return buffer;
+    }
+};
+
+// Texto fijo que se puede pasar como parametro de plantilla:
+// ConsultaFija<"empleados", ...>
+template<size_t N>
+struct TextoFijo {
+    char texto[N] = {};
+
+    constexpr TextoFijo(const char (&s)[N]) {
+        for (size_t i = 0; i < N; i++)
+            texto[i] = s[i];
+    }
+    constexpr size_t size() const { return N - 1; }
+    constexpr string_view vista() const { return string_view(texto, N - 1); }
+};
+
+// Lista de columnas de una ConsultaFija: Columnas<"id", "nombre">
+template<TextoFijo... Nombres>
+struct Columnas {};
+
+// Consulta cuya forma (tabla, columnas, columna del WHERE, ORDER BY y LIMIT)
+// se conoce al compilar: el texto se arma en tiempo de compilacion y al
+// ejecutar solo se copia, agregando el valor del WHERE. Una consulta mal
+// formada (sin tabla, sin columnas, nombres invalidos) no compila.
+//   using Analistas = ConsultaFija<"empleados", Columnas<"id", "nombre">,
+//                                  "posicion", "nombre ASC", 10>;
+//   string q = Analistas::build("Analista");
+template<TextoFijo Tabla, typename Cols, TextoFijo Filtro = "", TextoFijo Orden = "", int Limite = -1>
+class ConsultaFija;
+
+template<TextoFijo Tabla, TextoFijo... Cols, TextoFijo Filtro, TextoFijo Orden, int Limite>
+class ConsultaFija<Tabla, Columnas<Cols...>, Filtro, Orden, Limite> {
+private:
+    static_assert(Tabla.size() > 0, "la consulta necesita una tabla");
+    static_assert(sizeof...(Cols) > 0, "la consulta necesita al menos una columna");
+    static_assert(esIdentificador(Tabla.vista()), "nombre de tabla invalido");
+    static_assert((esIdentificador(Cols.vista()) && ...), "nombre de columna invalido");
+    static_assert(Filtro.size() == 0 || esIdentificador(Filtro.vista()), "columna del WHERE invalida");
+    static_assert(Orden.size() == 0 || esOrden(Orden.vista()), "ORDER BY invalido (columna [ASC|DESC])");
+    static_assert(Limite >= -1, "LIMIT invalido");
+
+    static constexpr bool conFiltro = Filtro.size() > 0;
+
+    // "SELECT ... FROM tabla" (+ " WHERE columna = '" si hay filtro)
+    static constexpr size_t largoPrefijo() {
+        size_t largo = 7 + ((Cols.size() + 2) + ... + 0) - 2 + 6 + Tabla.size();
+        if (conFiltro)
+            largo += 7 + Filtro.size() + 4;
+        return largo;
+    }
+
+    // "'" si hay filtro, " ORDER BY ..." y " LIMIT n"
+    static constexpr size_t largoSufijo() {
+        size_t largo = conFiltro ? 1 : 0;
+        if (Orden.size() > 0)
+            largo += 10 + Orden.size();
+        if (Limite >= 0) {
+            largo += 7 + 1;
+            for (int n = Limite; n >= 10; n /= 10)
+                largo++;
+        }
+        return largo;
+    }
+
+    static constexpr array<char, largoPrefijo() + largoSufijo()> armar() {
+        array<char, largoPrefijo() + largoSufijo()> texto = {};
+        size_t pos = 0;
+        auto poner = [&](string_view s) {
+            for (char c : s)
+                texto[pos++] = c;
+        };
+        poner("SELECT ");
+        bool primera = true;
+        ((poner(primera ? "" : ", "), primera = false, poner(Cols.vista())), ...);
+        poner(" FROM ");
+        poner(Tabla.vista());
+        if (conFiltro) {
+            poner(" WHERE ");
+            poner(Filtro.vista());
+            poner(" = '");
+            poner("'");
+        }
+        if (Orden.size() > 0) {
+            poner(" ORDER BY ");
+            poner(Orden.vista());
+        }
+        if (Limite >= 0) {
+            poner(" LIMIT ");
+            size_t fin = texto.size();
+            for (int n = Limite; ; n /= 10) {
+                texto[--fin] = char('0' + n % 10);
+                if (n < 10)
+                    break;
+            }
+        }
+        return texto;
+    }
+
+    // Prefijo y sufijo van seguidos; el valor del WHERE se copia entre ambos
+    static constexpr array<char, largoPrefijo() + largoSufijo()> texto = armar();
+
+public:
+    // Consulta completa (solo si no tiene WHERE)
+    static constexpr string_view build() requires (!conFiltro) {
+        return string_view(texto.data(), texto.size());
+    }
+
+    // Largo de la consulta con este valor en el WHERE
+    static size_t longitud(string_view valor) requires conFiltro {
+        size_t largo = texto.size() + valor.size();
+        for (char c : valor)
+            largo += c == '\'';      // las comillas del valor se duplican
+        return largo;
+    }
+
+    // Escribe la consulta con "valor" en el WHERE y devuelve su largo
+    static size_t build(string_view valor, char* destino, size_t capacidad) requires conFiltro {
+        size_t largo = longitud(valor);
+        if (largo > capacidad)
+            throw length_error("el buffer no alcanza para la consulta");
+        memcpy(destino, texto.data(), largoPrefijo());
+        char* p = destino + largoPrefijo();
+        if (largo == texto.size() + valor.size()) {
+            memcpy(p, valor.data(), valor.size());
+            p += valor.size();
+        } else {
+            for (char c : valor) {
+                if (c == '\'')
+                    *p++ = '\'';
+                *p++ = c;
+            }
+        }
+        memcpy(p, texto.data() + largoPrefijo(), largoSufijo());
+        return largo;
+    }
+
+    static string_view build(string_view valor, string& buffer) requires conFiltro {
+        buffer.resize(longitud(valor));
+        build(valor, buffer.data(), buffer.size());
+        return buffer;
+    }
+
+    static string build(string_view valor) requires conFiltro {
+        string consulta;
+        build(valor, consulta);
+        return consulta;
+    }
+};
+
+// Compara el build() original con SQLQueryBuilderVista y ConsultaFija
+// armando "n" consultas con distintos valores en el WHERE: consultas por
+// segundo y reservas de memoria por consulta
+void medirBuilders(int n) {
+    vector<string> valores;
+    for (int i = 0; i < 1000; i++)
+        valores.push_back("Analista_" + to_string(i));
+
+    size_t largoTotal = 0;
+    size_t antes = asignaciones;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        string query = SQLQueryBuilder()
+            .setTable("empleados")
+            .addColumn("id")
+            .addColumn("posicion")
+            .addColumn("nombre")
+            .setWhereClause("position", valores[i % valores.size()])
+            .setOrderByClause("nombre ASC")
+            .setLimit(10)
+            .build();
+        largoTotal += query.size();
+    }
+    auto t1 = chrono::steady_clock::now();
+    size_t asignacionesOriginal = asignaciones - antes;
+
+    SQLQueryBuilderVista builder;
+    string buffer;
+    size_t largoVista = 0;
+    antes = asignaciones;
+    auto t2 = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        string_view query = builder.reset()
+            .setTable("empleados")
+            .addColumn("id")
+            .addColumn("posicion")
+            .addColumn("nombre")
+            .setWhereClause("position", valores[i % valores.size()])
+            .setOrderByClause("nombre ASC")
+            .setLimit(10)
+            .build(buffer);
+        largoVista += query.size();
+    }
+    auto t3 = chrono::steady_clock::now();
+    size_t asignacionesVista = asignaciones - antes;
+
+    using ConsultaAnalistas = ConsultaFija<"empleados", Columnas<"id", "posicion", "nombre">,
+                                           "position", "nombre ASC", 10>;
+    size_t largoFija = 0;
+    antes = asignaciones;
+    auto t4 = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+        largoFija += ConsultaAnalistas::build(valores[i % valores.size()], buffer).size();
+    auto t5 = chrono::steady_clock::now();
+    size_t asignacionesFija = asignaciones - antes;
+
+    cout << "build() original: " << n / chrono::duration<double>(t1 - t0).count()
+         << " consultas/s, " << (double)asignacionesOriginal / n << " reservas/consulta" << endl;
+    cout << "SQLQueryBuilderVista: " << n / chrono::duration<double>(t3 - t2).count()
+         << " consultas/s, " << (double)asignacionesVista / n << " reservas/consulta"
+         << (largoVista == largoTotal ? "" : " (NO COINCIDEN)") << endl;
+    cout << "ConsultaFija: " << n / chrono::duration<double>(t5 - t4).count()
+         << " consultas/s, " << (double)asignacionesFija / n << " reservas/consulta"
+         << (largoFija == largoTotal ? "" : " (NO COINCIDEN)") << endl;
+}
+
+// Busca en CacheSentencias "n" consultas que solo cambian en el valor del
+// WHERE: armando la forma cada vez (builder nuevo) y reusando el builder,
+// que guarda la forma y su hash. Consultas por segundo y reservas por consulta
+void medirSentencias(int n) {
+    vector<string> valores;
+    for (int i = 0; i < 1000; i++)
+        valores.push_back("Analista_" + to_string(i));
+    EjecutorSimulado ejecutor;
+    CacheSentencias cache(ejecutor, 64);
+
+    long long ids = 0;
+    size_t antes = asignaciones;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        ConsultaParametrizada consulta = SQLQueryBuilder()   // copia: el builder no sigue vivo
+            .setTable("empleados")
+            .addColumn("id")
+            .addColumn("nombre")
+            .setWhereClause("position", valores[i % valores.size()])
+            .buildParametrizada();
+        ids += cache.obtener(consulta.forma)->id;
+    }
+    auto t1 = chrono::steady_clock::now();
+    size_t asignacionesNuevo = asignaciones - antes;
+
+    SQLQueryBuilder builder;
+    builder.setTable("empleados").addColumn("id").addColumn("nombre");
+    builder.setWhereClause("position", valores[0]).buildParametrizada();   // arma la forma
+    antes = asignaciones;
+    auto t2 = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+        const ConsultaParametrizada& consulta =
+            builder.setWhereClause("position", valores[i % valores.size()]).buildParametrizada();
+        ids += cache.obtener(consulta.forma, consulta.hashForma)->id;
+    }
+    auto t3 = chrono::steady_clock::now();
+    size_t asignacionesReusado = asignaciones - antes;
+
+    cout << "Forma armada cada vez: " << n / chrono::duration<double>(t1 - t0).count()
+         << " consultas/s, " << (double)asignacionesNuevo / n << " reservas/consulta" << endl;
+    cout << "Forma guardada en el builder: " << n / chrono::duration<double>(t3 - t2).count()
+         << " consultas/s, " << (double)asignacionesReusado / n << " reservas/consulta" << endl;
+    cout << "Compilaciones: " << ejecutor.getCompilaciones() << " (ids " << ids << ")" << endl;
+}
+
+// Funcion que recibe los bytes que se van generando (archivo, socket, ...)
+using Escritor = function<void(string_view)>;
+
+// Escritor que manda los bytes a un descriptor de archivo abierto
+Escritor escritorDescriptor(int fd) {
+    return [fd](string_view datos) {
+        while (!datos.empty()) {
+            ssize_t escritos = ::write(fd, datos.data(), datos.size());
+            if (escritos < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw runtime_error(string("no se pudo escribir: ") + strerror(errno));
+            }
+            datos.remove_prefix((size_t)escritos);
+        }
+    };
+}
+
+// Arma sentencias INSERT de muchas filas a la vez:
+//   INSERT INTO tabla (a, b) VALUES
+//   (1, 'x'),
+//   (2, 'y');
+// Cada sentencia se corta al llegar a "maxFilas" filas o "maxBytes" bytes y
+// el texto se entrega al escritor en bloques de 64 KB, asi que la memoria no
+// crece con la cantidad de filas. Las filas pueden ser tuplas o rangos de
+// valores: enteros, reales, textos (se escapan las comillas), nullptr u
+// optional vacio (NULL). Al final hay que llamar a terminar().
+class InsercionPorLotes {
+private:
+    static constexpr size_t TAM_BLOQUE = 64 * 1024;
+
+    string cabecera;               // "INSERT INTO tabla (a, b) VALUES\n"
+    string cierre = ";\n";         // con upsert lleva el ON CONFLICT
+    vector<string> nombres;
+    size_t maxFilas, maxBytes;
+    Escritor escritor;
+    string bloque;                 // bytes que todavia no se entregaron
+    string fila;                   // fila actual ya escapada (se reutiliza)
+    size_t valoresFila = 0;
+    size_t filasSentencia = 0;
+    size_t bytesSentencia = 0;
+    size_t filas = 0;
+    size_t sentencias = 0;
+    size_t bytes = 0;
+
+    void escribirValor(nullptr_t) {
+        fila += "NULL";
+    }
+
+    void escribirValor(string_view v) {
+        fila += '\'';
+        for (char c : v) {
+            if (c == '\0')
+                throw invalid_argument("texto con caracter nulo");
+            if (c == '\'')
+                fila += '\'';          // ' se escribe ''
+            fila += c;
+        }
+        fila += '\'';
+    }
+
+    void escribirValor(const char* v) { escribirValor(string_view(v)); }
+    void escribirValor(const string& v) { escribirValor(string_view(v)); }
+
+    void escribirValor(bool v) { fila += v ? "TRUE" : "FALSE"; }
+
+    // Un char suelto no es un numero ni un texto: se pide como string
+    void escribirValor(char) = delete;
+
+    template<typename T>
+        requires ((is_integral_v<T> || is_floating_point_v<T>) &&
+                  !is_same_v<T, bool> && !is_same_v<T, char>)
+    void escribirValor(T v) {
+        if constexpr (is_floating_point_v<T>) {
+            if (!isfinite(v))
+                throw invalid_argument("numero no finito");
+        }
+        char digitos[32];
+        fila.append(digitos, to_chars(digitos, digitos + sizeof(digitos), v).ptr);
+    }
+
+    template<typename T>
+    void escribirValor(const optional<T>& v) {
+        if (v)
+            escribirValor(*v);
+        else
+            fila += "NULL";
+    }
+
+    template<typename T>
+    void valor(const T& v) {
+        fila += valoresFila++ == 0 ? "(" : ", ";
+        escribirValor(v);
+    }
+
+    void emitir(string_view datos) {
+        bloque += datos;
+        bytesSentencia += datos.size();
+        if (bloque.size() >= TAM_BLOQUE)
+            vaciar();
+    }
+
+    void vaciar() {
+        if (bloque.empty())
+            return;
+        escritor(bloque);
+        bytes += bloque.size();
+        bloque.clear();
+    }
+
+    void cerrarSentencia() {
+        if (filasSentencia == 0)
+            return;
+        emitir(cierre);
+        sentencias++;
+        filasSentencia = 0;
+        bytesSentencia = 0;
+    }
+
+public:
+    InsercionPorLotes(const string& tabla, const vector<string>& nombres, Escritor escritor,
+                      size_t maxFilas = 1000, size_t maxBytes = 1 << 20)
+        : nombres(nombres), maxFilas(max<size_t>(maxFilas, 1)), maxBytes(maxBytes),
+          escritor(std::move(escritor)) {
+        if (nombres.empty())
+            throw invalid_argument("el INSERT necesita al menos una columna");
+        cabecera = "INSERT INTO " + tabla + " (";
+        for (size_t i = 0; i < nombres.size(); i++)
+            cabecera += (i ? ", " : "") + nombres[i];
+        cabecera += ") VALUES\n";
+        bloque.reserve(TAM_BLOQUE + 4096);
+    }
+
+    // Convierte las sentencias en UPSERT: si una fila choca con "claves" se
+    // actualizan las demas columnas (ON CONFLICT de PostgreSQL y SQLite).
+    // Hay que llamarlo antes de agregar filas.
+    InsercionPorLotes& upsert(const vector<string>& claves) {
+        if (filas > 0)
+            throw logic_error("upsert() va antes de la primera fila");
+        cierre = "\nON CONFLICT (";
+        for (size_t i = 0; i < claves.size(); i++)
+            cierre += (i ? ", " : "") + claves[i];
+        cierre += ")";
+        string cambios;
+        for (const string& nombre : nombres)
+            if (find(claves.begin(), claves.end(), nombre) == claves.end())
+                cambios += (cambios.empty() ? "" : ", ") + nombre + " = EXCLUDED." + nombre;
+        cierre += cambios.empty() ? " DO NOTHING;\n" : " DO UPDATE SET " + cambios + ";\n";
+        return *this;
+    }
+
+    template<typename Fila>
+    void agregarFila(const Fila& f) {
+        fila.clear();
+        valoresFila = 0;
+        if constexpr (requires { tuple_size<Fila>::value; })
+            apply([this](const auto&... valores) { (valor(valores), ...); }, f);
+        else
+            for (const auto& v : f)
+                valor(v);
+        if (valoresFila != nombres.size())
+            throw invalid_argument("la fila no tiene un valor por columna");
+        fila += ')';
+
+        // Si la fila no entra en la sentencia actual se empieza otra (una
+        // fila que sola ya supera maxBytes va en una sentencia propia)
+        if (filasSentencia > 0 && (filasSentencia == maxFilas ||
+                                   bytesSentencia + 2 + fila.size() + cierre.size() > maxBytes))
+            cerrarSentencia();
+        emitir(filasSentencia == 0 ? string_view(cabecera) : string_view(",\n"));
+        emitir(fila);
+        filasSentencia++;
+        filas++;
+    }
+
+    // Agrega todas las filas de [inicio, fin)
+    template<typename Iterador>
+    void agregar(Iterador inicio, Iterador fin) {
+        for (; inicio != fin; ++inicio)
+            agregarFila(*inicio);
+    }
+
+    // Cierra la ultima sentencia y entrega lo que quede al escritor
+    void terminar() {
+        cerrarSentencia();
+        vaciar();
+    }
+
+    size_t getFilas() const { return filas; }
+    size_t getSentencias() const { return sentencias; }
+    size_t getBytes() const { return bytes; }
+};
+
+// Inserta "n" filas generadas al vuelo (no se guardan en memoria) en un
+// archivo: filas por segundo y memoria maxima del proceso
+void medirInsercion(int n) {
+    const char* ruta = "insercion.sql";
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw runtime_error(string("no se pudo crear ") + ruta);
+
+    auto filas = views::iota(0, n) | views::transform([](int i) {
+        optional<double> salario;
+        if (i % 7 != 0)
+            salario = 1000.5 + i % 9000;
+        return tuple<int, string, optional<double>>(i, "Empleado_" + to_string(i) + (i % 10 ? "" : "'s"), salario);
+    });
+
+    InsercionPorLotes insercion("empleados", {"id", "nombre", "salario"}, escritorDescriptor(fd),
+                                1000, 256 * 1024);
+    insercion.upsert({"id"});
+    auto t0 = chrono::steady_clock::now();
+    insercion.agregar(filas.begin(), filas.end());
+    insercion.terminar();
+    auto t1 = chrono::steady_clock::now();
+    close(fd);
+    remove(ruta);
+
+    rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    cout << insercion.getFilas() << " filas en " << insercion.getSentencias() << " sentencias ("
+         << insercion.getBytes() / (1024 * 1024) << " MB): "
+         << insercion.getFilas() / chrono::duration<double>(t1 - t0).count() << " filas/s, "
+         << "memoria maxima del proceso " << uso.ru_maxrss / 1024 << " MB" << endl;
+}
+
 int main() {
     try {
         // Construcción de ejemplo de una consulta SQL
@@ -240,6 +1357,77 @@ int main() {
              << e.what() << endl;
     }
 
+    // Misma consulta sin reservar memoria (buffer reutilizable) y comparacion
+    /*
+    string buffer;
+    SQLQueryBuilderVista builder;
+    cout << builder.setTable("empleados")
+                   .addColumn("id")
+                   .addColumn("nombre")
+                   .setWhereClause("position", "Analista")
+                   .setLimit(10)
+                   .build(buffer) << endl;
+    medirBuilders(1000000);
+    */
+
+    // INSERT de muchas filas por sentencia, escrito directo a la salida
+    /*
+    InsercionPorLotes insercion("empleados", {"id", "nombre", "posicion"},
+                                escritorDescriptor(STDOUT_FILENO), 2);
+    vector<tuple<int, string, optional<string>>> nuevos = {
+        {1, "Lucia", "Analista"}, {2, "O'Brien", nullopt}, {3, "Ana", "Gerente"}};
+    insercion.upsert({"id"});
+    insercion.agregar(nuevos.begin(), nuevos.end());   // 2 sentencias: 2 filas y 1
+    insercion.terminar();
+    medirInsercion(5000000);
+    */
+
+    // Consulta armada al compilar: solo se copia el valor del WHERE
+    /*
+    using ConsultaAnalistas = ConsultaFija<"empleados", Columnas<"id", "posicion", "nombre">,
+                                           "position", "nombre ASC", 10>;
+    cout << ConsultaAnalistas::build("Analista") << endl;
+    cout << ConsultaFija<"empleados", Columnas<"id", "nombre">>::build() << endl;
+    // ConsultaFija<"empleados", Columnas<>>::build();  // no compila: sin columnas
+    */
+
+    // Consultas parametrizadas con cache de sentencias preparadas
+    /*
+    EjecutorSimulado ejecutor;
+    CacheSentencias cache(ejecutor, 64);
+    for (string puesto : {"Analista", "Gerente", "O'Brien", "Analista"}) {
+        ConsultaParametrizada consulta = SQLQueryBuilder()
+            .setTable("empleados")
+            .addColumn("id")
+            .addColumn("nombre")
+            .setWhereClause("position", puesto)
+            .buildParametrizada();                 // ... WHERE position = ?
+        cout << cache.ejecutar(consulta) << endl;
+    }
+    cache.mostrarEstadisticas();                   // 3 aciertos, 1 fallo
+    cout << "Compilaciones: " << ejecutor.getCompilaciones() << endl;  // 1
+    medirSentencias(1000000);
+    */
+
+    // Ejecutar la consulta sobre una tabla en memoria (por columnas)
+    /*
+    BaseEnMemoria base;
+    TablaColumnar& empleados = base.crearTabla("empleados",
+        {{"id", false}, {"posicion", true}, {"nombre", true}});
+    empleados.agregarFila({"1", "Analista", "Lucia"});
+    empleados.agregarFila({"2", "Gerente", "Mario"});
+    empleados.agregarFila({"3", "Analista", "Ana"});
+    SQLQueryBuilder consulta;
+    consulta.setTable("empleados")
+            .addColumn("id")
+            .addColumn("nombre")
+            .setWhereClause("posicion", "Analista")
+            .setOrderByClause("nombre ASC")
+            .setLimit(10);
+    base.ejecutar(consulta).mostrar();   // 3 | Ana  y  1 | Lucia
+    medirMotor(1000000);
+    */
+
     // Ejemplo 1: Uso de AppFactory para crear App según sistema operativo
     /*
     AppFactory* factory;
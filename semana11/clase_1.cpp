@@ -1,7 +1,30 @@
 // PATRONES DE DISEÑO II
 
 #include <iostream>
-#include <set>       // conjunto ordenado
+#include <string_view>
+#include <unordered_set>
+#include <algorithm>
+#include <fstream>
+#include <cstdint>
+#include <cstring>   // strerror
+#include <cerrno>
+#include <fcntl.h>   // open
+#include <unistd.h>  // close
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <future>     // para que varios hilos esperen la misma carga
+#include <deque>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <random>
 using namespace std;
 
 /*
@@ -87,34 +110,750 @@ public:
     }
 };
 
-// Proxy que filtra sitios prohibidos antes de mostrar
+// Lista negra de sitios compartida por todos los proxies (solo POSIX para
+// cargarla con mmap). Cada entrada es un dominio, que bloquea tambien sus
+// subdominios ("sitio.com" bloquea "www.sitio.com"), o un dominio con ruta,
+// que bloquea esa ruta y lo que cuelga de ella ("sitio.com/privado"
+// bloquea "sitio.com/privado/a" pero no "sitio.com/privados"). Una entrada
+// con ruta vale solo para ese dominio exacto: "sitio.com/privado" no
+// bloquea "www.sitio.com/privado" (hay que agregar ese dominio aparte).
+// Las URLs se normalizan dando vuelta el dominio ("www.sitio.com/a" queda
+// "com.sitio.www/a"), asi ambos casos son "la entrada es prefijo de la URL
+// y termina en un '.' o un '/'".
+// Se guarda en un solo bloque de memoria que es igual al archivo:
+//   cabecera | filtro de Bloom | nodos del trie | etiquetas
+// El filtro de Bloom descarta casi todas las URLs permitidas sin tocar el
+// trie; el trie (compacto: cada arista lleva un texto, no una letra)
+// confirma los positivos.
+
+// Normaliza una URL: sin "http://", dominio en minusculas y dado vuelta,
+// sin puerto, sin "?consulta" ni "#fragmento" ni '/' final
+void normalizarUrl(string_view url, string& salida) {
+    size_t esquema = url.find("://");
+    if (esquema != string_view::npos)
+        url.remove_prefix(esquema + 3);
+    // (se recorre a mano: find_first_of prueba cada caracter contra la lista)
+    size_t finDominio = 0, finPuerto = url.size();
+    while (finDominio < url.size() && url[finDominio] != '/' &&
+           url[finDominio] != '?' && url[finDominio] != '#') {
+        if (url[finDominio] == ':' && finPuerto == url.size())
+            finPuerto = finDominio;
+        finDominio++;
+    }
+    string_view dominio = url.substr(0, min(finDominio, finPuerto));
+    size_t finRuta = finDominio;
+    while (finRuta < url.size() && url[finRuta] != '?' && url[finRuta] != '#')
+        finRuta++;
+    string_view ruta = url.substr(finDominio, finRuta - finDominio);
+    while (!dominio.empty() && dominio.back() == '.')
+        dominio.remove_suffix(1);
+    while (!ruta.empty() && ruta.back() == '/')
+        ruta.remove_suffix(1);
+
+    // Se copian las partes del dominio de atras hacia adelante
+    salida.resize(dominio.size() + ruta.size());
+    char* p = salida.data();
+    auto copiarParte = [&p, dominio](size_t inicio, size_t fin) {
+        for (size_t i = inicio; i < fin; i++) {
+            char c = dominio[i];
+            *p++ = (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+        }
+    };
+    size_t fin = dominio.size();
+    for (size_t i = dominio.size(); i-- > 0;) {
+        if (dominio[i] == '.') {
+            copiarParte(i + 1, fin);
+            *p++ = '.';
+            fin = i;
+        }
+    }
+    copiarParte(0, fin);
+    if (!ruta.empty())
+        memcpy(p, ruta.data(), ruta.size());
+}
+
+class ListaNegra {
+public:
+    // Nodo del trie; la etiqueta es el texto de la arista que llega a el
+    struct NodoTrie {
+        uint32_t etiqueta;     // posicion en "etiquetas"
+        uint32_t largo;
+        uint32_t primerHijo;   // los hijos van seguidos, ordenados por su primer caracter
+        uint32_t hijos;
+        uint32_t terminal;     // 1 si aqui termina una entrada
+    };
+
+    struct Cabecera {
+        uint64_t magia;
+        uint64_t entradas;
+        uint64_t bitsBloom;    // potencia de 2
+        uint64_t hashesBloom;
+        uint64_t nodos;
+        uint64_t bytesEtiquetas;
+    };
+
+    static constexpr uint64_t MAGIA = 0x3130415247454e4cULL;   // "LNEGRA01"
+    static constexpr uint64_t MAX_HASHES_BLOOM = 16;            // cota al cargar un bloque
+
+    // Segundo hash del filtro de Bloom (splitmix64)
+    static uint64_t mezclar(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+private:
+    vector<uint64_t> datos;        // bloque propio (si no viene de un archivo)
+    void* mapa = nullptr;          // bloque mapeado del archivo
+    size_t tamMapa = 0;
+    const Cabecera* cabecera;
+    const uint64_t* bloom;
+    const NodoTrie* nodos;
+    const char* etiquetas;
+
+    // Ubica cada parte dentro del bloque y verifica que entren y que el
+    // trie no apunte afuera (el archivo puede estar truncado o corrupto)
+    void ubicar(const void* bloque, size_t tam) {
+        if (tam < sizeof(Cabecera))
+            throw runtime_error("ListaNegra: bloque demasiado chico");
+        cabecera = (const Cabecera*)bloque;
+        const Cabecera& c = *cabecera;
+        if (c.magia != MAGIA || c.bitsBloom < 64 || (c.bitsBloom & (c.bitsBloom - 1)) != 0 ||
+            c.hashesBloom == 0 || c.hashesBloom > MAX_HASHES_BLOOM ||
+            c.nodos == 0 || c.nodos > UINT32_MAX || c.bytesEtiquetas > UINT32_MAX)
+            throw runtime_error("ListaNegra: formato invalido");
+        size_t necesario = sizeof(Cabecera) + c.bitsBloom / 8 + c.nodos * sizeof(NodoTrie) + c.bytesEtiquetas;
+        if (tam < necesario)
+            throw runtime_error("ListaNegra: archivo incompleto");
+        bloom = (const uint64_t*)(cabecera + 1);
+        nodos = (const NodoTrie*)(bloom + c.bitsBloom / 64);
+        etiquetas = (const char*)(nodos + c.nodos);
+
+        // Cada etiqueta dentro de "etiquetas" y cada hijo dentro de "nodos";
+        // los hijos tienen etiqueta no vacia, asi la busqueda siempre avanza
+        for (uint64_t i = 0; i < c.nodos; i++) {
+            const NodoTrie& n = nodos[i];
+            if ((uint64_t)n.etiqueta + n.largo > c.bytesEtiquetas || n.hijos > 256 ||
+                (uint64_t)n.primerHijo + n.hijos > c.nodos)
+                throw runtime_error("ListaNegra: formato invalido");
+            for (uint32_t h = 0; h < n.hijos; h++) {
+                if (nodos[n.primerHijo + h].largo == 0)
+                    throw runtime_error("ListaNegra: formato invalido");
+            }
+        }
+    }
+
+    bool quizasEsta(uint64_t hash) const {
+        uint64_t h1 = hash, h2 = mezclar(hash) | 1;
+        uint64_t mascara = cabecera->bitsBloom - 1;
+        for (uint64_t i = 0; i < cabecera->hashesBloom; i++) {
+            uint64_t bit = (h1 + i * h2) & mascara;
+            if ((bloom[bit / 64] >> (bit % 64) & 1) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    // Busca en el trie alguna entrada que sea prefijo de "clave" y termine
+    // en un limite ('.', '/' o el final de la clave)
+    bool buscarEnTrie(string_view clave) const {
+        const NodoTrie* nodo = &nodos[0];
+        size_t i = 0;
+        while (true) {
+            if (nodo->terminal && (i == clave.size() || clave[i] == '.' || clave[i] == '/'))
+                return true;
+            if (i == clave.size() || nodo->hijos == 0)
+                return false;
+            // Hijo cuya etiqueta empieza con clave[i] (busqueda binaria)
+            unsigned char c = clave[i];
+            const NodoTrie* desde = &nodos[nodo->primerHijo];
+            const NodoTrie* hasta = desde + nodo->hijos;
+            while (desde < hasta) {
+                const NodoTrie* medio = desde + (hasta - desde) / 2;
+                if ((unsigned char)etiquetas[medio->etiqueta] < c)
+                    desde = medio + 1;
+                else
+                    hasta = medio;
+            }
+            if (desde == &nodos[nodo->primerHijo] + nodo->hijos ||
+                (unsigned char)etiquetas[desde->etiqueta] != c)
+                return false;
+            string_view etiqueta(etiquetas + desde->etiqueta, desde->largo);
+            if (clave.substr(i, etiqueta.size()) != etiqueta)
+                return false;
+            i += etiqueta.size();
+            nodo = desde;
+        }
+    }
+
+public:
+    // Usa un bloque armado en memoria (por ConstructorListaNegra)
+    ListaNegra(vector<uint64_t> bloque) : datos(std::move(bloque)) {
+        ubicar(datos.data(), datos.size() * sizeof(uint64_t));
+    }
+
+    // Mapea un archivo guardado con ConstructorListaNegra::guardar. Al
+    // cargar solo se recorren los nodos del trie para validarlos; el filtro
+    // y las etiquetas se leen cuando las busquedas tocan cada pagina
+    ListaNegra(const string& ruta) {
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw runtime_error("ListaNegra: no se pudo abrir " + ruta + ": " + strerror(errno));
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            throw runtime_error("ListaNegra: archivo vacio o ilegible: " + ruta);
+        }
+        tamMapa = (size_t)info.st_size;
+        mapa = mmap(nullptr, tamMapa, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapa == MAP_FAILED) {
+            mapa = nullptr;
+            throw runtime_error("ListaNegra: mmap: " + string(strerror(errno)));
+        }
+        try {
+            ubicar(mapa, tamMapa);
+        } catch (...) {
+            munmap(mapa, tamMapa);
+            throw;
+        }
+    }
+
+    ~ListaNegra() {
+        if (mapa != nullptr)
+            munmap(mapa, tamMapa);
+    }
+
+    ListaNegra(const ListaNegra&) = delete;
+    ListaNegra& operator=(const ListaNegra&) = delete;
+
+    bool bloqueada(string_view url) const {
+        thread_local string clave;
+        normalizarUrl(url, clave);
+        // Se prueba en el filtro cada prefijo que termina en un limite; el
+        // hash (FNV-1a) se calcula de una pasada
+        uint64_t hash = 1469598103934665603ULL;
+        bool quizas = false;
+        for (size_t i = 0; i <= clave.size() && !quizas; i++) {
+            if (i == clave.size() || clave[i] == '.' || clave[i] == '/')
+                quizas = quizasEsta(hash);
+            if (i < clave.size())
+                hash = (hash ^ (unsigned char)clave[i]) * 1099511628211ULL;
+        }
+        return quizas && buscarEnTrie(clave);
+    }
+
+    size_t size() const { return cabecera->entradas; }
+
+    // El bloque completo, tal como se guarda en el archivo
+    string_view bytes() const {
+        size_t tam = sizeof(Cabecera) + cabecera->bitsBloom / 8 +
+                     cabecera->nodos * sizeof(NodoTrie) + cabecera->bytesEtiquetas;
+        return string_view((const char*)cabecera, tam);
+    }
+};
+
+// Arma una ListaNegra "fuera de linea": se agregan todas las entradas y
+// despues se construye el bloque (o se guarda en un archivo para mapearlo)
+class ConstructorListaNegra {
+private:
+    vector<string> claves;
+
+    static size_t prefijoComun(const string& a, const string& b, size_t desde) {
+        size_t i = desde;
+        while (i < a.size() && i < b.size() && a[i] == b[i])
+            i++;
+        return i;
+    }
+
+    // Las claves [lo, hi) comparten los primeros "prof" caracteres
+    void construirNodo(vector<ListaNegra::NodoTrie>& nodos, string& etiquetas,
+                       size_t nodo, size_t lo, size_t hi, size_t prof) {
+        if (lo < hi && claves[lo].size() == prof) {
+            nodos[nodo].terminal = 1;
+            lo++;
+        }
+        vector<pair<size_t, size_t>> grupos;     // claves con el mismo caracter en "prof"
+        for (size_t a = lo; a < hi;) {
+            size_t b = a + 1;
+            while (b < hi && claves[b][prof] == claves[a][prof])
+                b++;
+            grupos.push_back({a, b});
+            a = b;
+        }
+        size_t primero = nodos.size();
+        nodos[nodo].primerHijo = (uint32_t)primero;
+        nodos[nodo].hijos = (uint32_t)grupos.size();
+        nodos.resize(primero + grupos.size());
+        for (size_t j = 0; j < grupos.size(); j++) {
+            auto [a, b] = grupos[j];
+            size_t comun = prefijoComun(claves[a], claves[b - 1], prof);
+            nodos[primero + j].etiqueta = (uint32_t)etiquetas.size();
+            nodos[primero + j].largo = (uint32_t)(comun - prof);
+            etiquetas.append(claves[a], prof, comun - prof);
+            construirNodo(nodos, etiquetas, primero + j, a, b, comun);
+        }
+    }
+
+public:
+    void agregar(string_view url) {
+        string clave;
+        normalizarUrl(url, clave);
+        if (!clave.empty())
+            claves.push_back(std::move(clave));
+    }
+
+    // Arma el bloque completo (cabecera, filtro de Bloom con ~10 bits por
+    // entrada, nodos y etiquetas)
+    vector<uint64_t> construir() {
+        sort(claves.begin(), claves.end());
+        claves.erase(unique(claves.begin(), claves.end()), claves.end());
+
+        // Se quitan las entradas tapadas por otra mas corta
+        // ("com.sitio.www" sobra si esta "com.sitio")
+        unordered_set<string_view> todas(claves.begin(), claves.end());
+        vector<string> utiles;
+        for (const string& clave : claves) {
+            bool tapada = false;
+            for (size_t i = 1; i < clave.size() && !tapada; i++)
+                if ((clave[i] == '.' || clave[i] == '/') && todas.count(string_view(clave).substr(0, i)))
+                    tapada = true;
+            if (!tapada)
+                utiles.push_back(clave);
+        }
+        todas.clear();
+        claves = std::move(utiles);
+
+        vector<ListaNegra::NodoTrie> nodos(1, ListaNegra::NodoTrie{0, 0, 0, 0, 0});
+        string etiquetas;
+        construirNodo(nodos, etiquetas, 0, 0, claves.size(), 0);
+
+        ListaNegra::Cabecera c;
+        c.magia = ListaNegra::MAGIA;
+        c.entradas = claves.size();
+        c.bitsBloom = 64;
+        while (c.bitsBloom < claves.size() * 10)
+            c.bitsBloom *= 2;
+        c.hashesBloom = 7;
+        c.nodos = nodos.size();
+        c.bytesEtiquetas = etiquetas.size();
+
+        size_t bytesNodos = nodos.size() * sizeof(ListaNegra::NodoTrie);
+        size_t total = sizeof(c) + c.bitsBloom / 8 + bytesNodos + etiquetas.size();
+        vector<uint64_t> bloque((total + 7) / 8, 0);
+        char* p = (char*)bloque.data();
+        memcpy(p, &c, sizeof(c));
+        uint64_t* bloom = (uint64_t*)(p + sizeof(c));
+        for (const string& clave : claves) {
+            uint64_t hash = 1469598103934665603ULL;
+            for (char ch : clave)
+                hash = (hash ^ (unsigned char)ch) * 1099511628211ULL;
+            uint64_t h2 = ListaNegra::mezclar(hash) | 1;   // como en quizasEsta
+            for (uint64_t i = 0; i < c.hashesBloom; i++) {
+                uint64_t bit = (hash + i * h2) & (c.bitsBloom - 1);
+                bloom[bit / 64] |= 1ULL << (bit % 64);
+            }
+        }
+        memcpy(p + sizeof(c) + c.bitsBloom / 8, nodos.data(), bytesNodos);
+        memcpy(p + sizeof(c) + c.bitsBloom / 8 + bytesNodos, etiquetas.data(), etiquetas.size());
+        claves.clear();
+        return bloque;
+    }
+
+    // Construye y escribe el bloque en "ruta" (para cargarlo con mmap)
+    void guardar(const string& ruta) {
+        ListaNegra lista(construir());
+        string_view bytes = lista.bytes();
+        string temporal = ruta + ".tmp";
+        ofstream archivo(temporal, ios::binary | ios::trunc);
+        archivo.write(bytes.data(), (streamsize)bytes.size());
+        archivo.close();
+        if (!archivo || rename(temporal.c_str(), ruta.c_str()) != 0)
+            throw runtime_error("ConstructorListaNegra: no se pudo guardar " + ruta);
+    }
+};
+
+// Lista negra vigente. Los proxies la leen sin copiarla y se puede
+// reemplazar en cualquier momento: quien ya la estaba usando termina con la
+// anterior, que se libera cuando nadie la usa. El candado solo cubre la
+// copia del puntero, no la busqueda.
+class ListaNegraVigente {
+private:
+    mutable mutex candado;
+    shared_ptr<const ListaNegra> actual;
+
+public:
+    ListaNegraVigente(shared_ptr<const ListaNegra> lista) : actual(std::move(lista)) {}
+
+    shared_ptr<const ListaNegra> obtener() const {
+        lock_guard<mutex> lock(candado);
+        return actual;
+    }
+
+    void reemplazar(shared_ptr<const ListaNegra> nueva) {
+        lock_guard<mutex> lock(candado);
+        actual.swap(nueva);
+    }   // la anterior se libera aqui, fuera del candado, si nadie mas la usa
+
+    bool bloqueada(string_view url) const {
+        return obtener()->bloqueada(url);
+    }
+};
+
+// Arma una lista con "n" dominios al azar (un cuarto con ruta), la guarda,
+// la vuelve a abrir con mmap y mide busquedas por segundo
+void medirListaNegra(int n, int consultas) {
+    const string ruta = "lista_negra.bin";
+    mt19937 gen(11);
+    auto dominio = [](int i) { return "sitio" + to_string(i) + ".com"; };
+    ConstructorListaNegra constructor;
+    for (int i = 0; i < n; i++)
+        constructor.agregar(dominio(i) + (i % 4 == 0 ? "/privado" : ""));
+    auto t0 = chrono::steady_clock::now();
+    constructor.guardar(ruta);
+    auto t1 = chrono::steady_clock::now();
+    ListaNegra lista(ruta);
+    auto t2 = chrono::steady_clock::now();
+
+    // Mitad URLs bloqueadas, mitad permitidas. Las bloqueadas por ruta usan
+    // el dominio exacto de la entrada (la ruta no cubre subdominios)
+    vector<string> urls;
+    for (int i = 0; i < consultas; i++) {
+        if (i % 2 == 0) {
+            int d = gen() % n;
+            if (d % 4 == 0)
+                urls.push_back("https://" + dominio(d) + "/privado/x");
+            else
+                urls.push_back("https://www." + dominio(d) + "/inicio");
+        }
+        else {
+            urls.push_back("https://www." + dominio(n + gen() % n) + "/inicio");
+        }
+    }
+    int bloqueadas = 0;
+    auto t3 = chrono::steady_clock::now();
+    for (const string& url : urls)
+        bloqueadas += lista.bloqueada(url);
+    auto t4 = chrono::steady_clock::now();
+    int porRuta = 0;                              // fuera de la medicion
+    for (const string& url : urls)
+        porRuta += url.ends_with("/privado/x") && lista.bloqueada(url);
+
+    cout << "Lista negra de " << lista.size() << " entradas (" << lista.bytes().size() / (1024 * 1024)
+         << " MB): armado " << chrono::duration<double>(t1 - t0).count() << " s, carga "
+         << chrono::duration<double, micro>(t2 - t1).count() << " us, "
+         << consultas / chrono::duration<double>(t4 - t3).count() << " busquedas/s ("
+         << bloqueadas << " bloqueadas, " << porRuta << " por ruta)" << endl;
+    remove(ruta.c_str());
+}
+
+// Hilos en segundo plano para adelantar trabajo (por ejemplo, descargar un
+// sitio que probablemente se va a abrir)
+class PoolPrecarga {
+private:
+    vector<thread> hilos;
+    deque<function<void()>> pendientes;
+    mutex candado;
+    condition_variable hayTrabajo;
+    bool cerrado = false;
+
+    void trabajar() {
+        while (true) {
+            function<void()> tarea;
+            {
+                unique_lock<mutex> lock(candado);
+                hayTrabajo.wait(lock, [this]() { return cerrado || !pendientes.empty(); });
+                if (pendientes.empty())
+                    return;
+                tarea = std::move(pendientes.front());
+                pendientes.pop_front();
+            }
+            tarea();
+        }
+    }
+
+public:
+    PoolPrecarga(int cantidad = 2) {
+        for (int i = 0; i < max(cantidad, 1); i++)
+            hilos.emplace_back(&PoolPrecarga::trabajar, this);
+    }
+
+    // Termina lo que quede pendiente y espera a los hilos
+    ~PoolPrecarga() {
+        {
+            lock_guard<mutex> lock(candado);
+            cerrado = true;
+        }
+        hayTrabajo.notify_all();
+        for (thread& t : hilos)
+            t.join();
+    }
+
+    void agregar(function<void()> tarea) {
+        {
+            lock_guard<mutex> lock(candado);
+            pendientes.push_back(std::move(tarea));
+        }
+        hayTrabajo.notify_one();
+    }
+};
+
+// Proxy que filtra sitios prohibidos antes de mostrar. El sitio real se
+// crea (y se descarga) recien en el primer visualizar de una URL permitida,
+// asi crear un proxy no descarga nada
 class ProxySitioWeb : public SitioWeb {
 private:
-    // Lista de URLs no permitidas
-    set<string> sitiosWebNoPermitidos = {
-        "www.sitioprohibido1.com",
-        "www.sitioprohibido2.com",
-        "www.sitioprohibido3.com"
+    // Sitio real, compartido con la precarga en segundo plano por si el
+    // proxy se destruye antes de que esta termine
+    struct Carga {
+        string url;
+        once_flag descargado;
+        unique_ptr<SitioWebSinProxy> sitio;
+
+        Carga(const string& url) : url(url) {}
+
+        // Lo crea una sola vez aunque lo pidan varios hilos a la vez
+        const SitioWebSinProxy& obtener() {
+            call_once(descargado, [this]() { sitio = make_unique<SitioWebSinProxy>(url); });
+            return *sitio;
+        }
     };
+
+    // Lista de URLs no permitidas (una sola para todos los proxies)
+    static ListaNegraVigente& sitiosWebNoPermitidos() {
+        static ListaNegraVigente lista([]() {
+            ConstructorListaNegra constructor;
+            constructor.agregar("www.sitioprohibido1.com");
+            constructor.agregar("www.sitioprohibido2.com");
+            constructor.agregar("www.sitioprohibido3.com");
+            return make_shared<const ListaNegra>(constructor.construir());
+        }());
+        return lista;
+    }
     string url;                   // URL solicitada
-    SitioWebSinProxy sitio;       // objeto real sin proxy
+    mutable once_flag creada;
+    mutable shared_ptr<Carga> carga;   // nullptr hasta que haga falta
+
+    Carga& obtenerCarga() const {
+        call_once(creada, [this]() { carga = make_shared<Carga>(url); });
+        return *carga;
+    }
 
 public:
-    // Constructor crea el objeto real con la misma URL
+    // Indica si la URL esta en la lista negra vigente
+    static bool bloqueada(const string& url) {
+        return sitiosWebNoPermitidos().bloqueada(url);
+    }
+
+    // Reemplaza la lista negra de todos los proxies (sin detenerlos)
+    static void cambiarListaNegra(shared_ptr<const ListaNegra> nueva) {
+        sitiosWebNoPermitidos().reemplazar(std::move(nueva));
+    }
+
+    // Constructor solo guarda la URL (el sitio real se crea al usarlo)
     ProxySitioWeb(const string& url)
-        : sitio(url), url(url) {}
+        : url(url) {}
+
+    // Aviso de que la pagina probablemente se va a abrir: la descarga en
+    // segundo plano para que visualizar no tenga que esperar
+    void precargar(PoolPrecarga& pool) const {
+        if (bloqueada(url))
+            return;
+        obtenerCarga();
+        shared_ptr<Carga> c = carga;
+        pool.agregar([c]() { c->obtener(); });
+    }
 
     // Antes de visualizar revisa si la URL está en la lista negra
     void visualizar() const override {
         // Si está prohibida simplemente no hace nada
-        if (sitiosWebNoPermitidos.count(url)) {
+        if (bloqueada(url)) {
             return;
         }
-        // Si no está prohibida delega al objeto real
-        sitio.visualizar();
+        // Si no está prohibida delega al objeto real (creandolo la primera vez)
+        obtenerCarga().obtener().visualizar();
+    }
+};
+
+// Servidor simulado: tarda "demora" en devolver el contenido de una URL
+class OrigenSimulado {
+private:
+    chrono::milliseconds demora;
+    atomic<int> cargas{0};
+
+public:
+    OrigenSimulado(chrono::milliseconds demora = chrono::milliseconds(20))
+        : demora(demora) {}
+
+    string cargar(const string& url) {
+        cargas++;
+        this_thread::sleep_for(demora);
+        return "<html>Contenido de " + url + "</html>";
+    }
+
+    int getCargas() const { return cargas; }
+};
+
+// Funcion que trae el contenido de una URL desde el servidor
+using Origen = function<string(const string&)>;
+
+// Cache de paginas compartida por varios hilos. Se divide en fragmentos
+// (cada uno con su propio mutex y su propia lista LRU) para que los hilos
+// no esperen todos por el mismo candado. Cada pagina vence a los "ttl" y,
+// si varios hilos piden a la vez una URL que no esta, solo uno la carga y
+// los demas esperan ese mismo resultado.
+class CacheSitios {
+private:
+    static constexpr int FRAGMENTOS = 16;
+
+    struct Entrada {
+        string url;
+        shared_ptr<const string> contenido;
+        chrono::steady_clock::time_point vence;
+    };
+
+    struct Fragmento {
+        mutex candado;
+        list<Entrada> usadas;                                    // al frente, la mas reciente
+        unordered_map<string, list<Entrada>::iterator> indice;
+        unordered_map<string, shared_future<shared_ptr<const string>>> cargando;
+    };
+
+    Origen origen;
+    size_t capacidadFragmento;
+    chrono::steady_clock::duration ttl;
+    Fragmento fragmentos[FRAGMENTOS];
+    atomic<size_t> aciertos{0}, fallos{0}, coalescidos{0}, desalojos{0}, vencidos{0};
+
+public:
+    CacheSitios(Origen origen, size_t capacidad, chrono::steady_clock::duration ttl)
+        : origen(std::move(origen)),
+          capacidadFragmento(max<size_t>(1, (capacidad + FRAGMENTOS - 1) / FRAGMENTOS)),
+          ttl(ttl) {}
+
+    shared_ptr<const string> obtener(const string& url) {
+        Fragmento& f = fragmentos[hash<string>{}(url) % FRAGMENTOS];
+        unique_lock<mutex> lock(f.candado);
+
+        auto it = f.indice.find(url);
+        if (it != f.indice.end()) {
+            if (it->second->vence > chrono::steady_clock::now()) {
+                aciertos++;
+                f.usadas.splice(f.usadas.begin(), f.usadas, it->second);
+                return it->second->contenido;
+            }
+            vencidos++;
+            f.usadas.erase(it->second);
+            f.indice.erase(it);
+        }
+
+        // Si otro hilo ya la esta cargando esperamos su resultado
+        auto enCurso = f.cargando.find(url);
+        if (enCurso != f.cargando.end()) {
+            coalescidos++;
+            shared_future<shared_ptr<const string>> resultado = enCurso->second;
+            lock.unlock();
+            return resultado.get();
+        }
+
+        // La cargamos nosotros (sin tener el candado durante la carga)
+        fallos++;
+        promise<shared_ptr<const string>> promesa;
+        f.cargando.emplace(url, promesa.get_future().share());
+        lock.unlock();
+
+        shared_ptr<const string> contenido;
+        try {
+            contenido = make_shared<const string>(origen(url));
+        } catch (...) {
+            lock.lock();
+            f.cargando.erase(url);
+            promesa.set_exception(current_exception());
+            throw;
+        }
+
+        lock.lock();
+        f.cargando.erase(url);
+        f.usadas.push_front(Entrada{url, contenido, chrono::steady_clock::now() + ttl});
+        f.indice[url] = f.usadas.begin();
+        if (f.usadas.size() > capacidadFragmento) {
+            f.indice.erase(f.usadas.back().url);
+            f.usadas.pop_back();
+            desalojos++;
+        }
+        lock.unlock();
+        promesa.set_value(contenido);
+        return contenido;
+    }
+
+    void mostrarEstadisticas() const {
+        size_t total = aciertos + fallos + coalescidos;
+        cout << "Cache de sitios: " << aciertos << " aciertos, " << fallos << " fallos, "
+             << coalescidos << " esperas a otra carga, " << desalojos << " desalojos, "
+             << vencidos << " vencidos (" << (total ? 100.0 * aciertos / total : 0)
+             << "% de aciertos)" << endl;
     }
 };
 
+// Proxy que guarda las paginas en una cache compartida: solo la primera
+// visita (o la primera despues de vencer) va al servidor
+class ProxySitioWebConCache : public SitioWeb {
+private:
+    string url;
+    CacheSitios& cache;
+
+public:
+    ProxySitioWebConCache(const string& url, CacheSitios& cache)
+        : url(url), cache(cache) {}
+
+    // Filtra con la misma lista negra que ProxySitioWeb y despues usa la cache
+    void visualizar() const override {
+        if (ProxySitioWeb::bloqueada(url))
+            return;
+        shared_ptr<const string> contenido = cache.obtener(url);
+        cout << "Visualizando el sitio web: " << url
+             << " (" << contenido->size() << " bytes)" << endl;
+    }
+};
+
+// Varios hilos piden "pedidos" paginas al azar entre "urls" distintas con
+// un servidor que tarda "demora": tiempo por pedido y cargas al servidor
+void medirCacheSitios(int hilos, int pedidos, int urls, chrono::milliseconds demora) {
+    OrigenSimulado servidor(demora);
+    CacheSitios cache([&servidor](const string& url) { return servidor.cargar(url); },
+                      2 * urls, chrono::seconds(60));   // holgura por fragmentos desparejos
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> trabajadores;
+    for (int h = 0; h < hilos; h++) {
+        trabajadores.emplace_back([&cache, h, pedidos, urls]() {
+            mt19937 gen(h);
+            for (int i = 0; i < pedidos; i++)
+                cache.obtener("www.sitio" + to_string(gen() % urls) + ".com");
+        });
+    }
+    for (thread& t : trabajadores)
+        t.join();
+    auto t1 = chrono::steady_clock::now();
+
+    // Con todo ya cargado, cuanto tarda una pagina que esta en la cache
+    string url = "www.sitio0.com";
+    cache.obtener(url);
+    auto t2 = chrono::steady_clock::now();
+    for (int i = 0; i < pedidos; i++)
+        cache.obtener(url);
+    auto t3 = chrono::steady_clock::now();
+
+    double total = (double)hilos * pedidos;
+    cout << "Sin cache: " << chrono::duration<double, micro>(demora).count() << " us por pedido" << endl;
+    cout << "Con cache: " << chrono::duration<double, micro>(t1 - t0).count() * hilos / total
+         << " us por pedido en promedio (" << servidor.getCargas() << " cargas al servidor), "
+         << chrono::duration<double, nano>(t3 - t2).count() / pedidos << " ns si ya esta en la cache"
+         << endl;
+    cache.mostrarEstadisticas();
+}
+
 int main() {
     // Usamos el Proxy para un sitio permitido
     SitioWeb* sitio = new ProxySitioWeb("www.sitiopermitido1.com");
@@ -131,6 +870,41 @@ int main() {
     sitio->visualizar();
     // Sin salida pues la URL está en la lista negra
 
+    // Lista negra grande cargada desde un archivo y cambiada en caliente
+    /*
+    ConstructorListaNegra constructor;
+    constructor.agregar("sitioprohibido4.com");            // y sus subdominios
+    constructor.agregar("www.sitiopermitido1.com/privado"); // solo esa ruta
+    constructor.guardar("lista_negra.bin");
+    ProxySitioWeb::cambiarListaNegra(make_shared<const ListaNegra>("lista_negra.bin"));
+    ProxySitioWeb("www.sitioprohibido4.com/inicio").visualizar();       // sin salida
+    ProxySitioWeb("www.sitiopermitido1.com/privado/a").visualizar();    // sin salida
+    ProxySitioWeb("www.sitiopermitido1.com/publico").visualizar();      // se muestra
+    medirListaNegra(1000000, 1000000);
+    */
+
+    // Precarga: la descarga ocurre en segundo plano y visualizar no espera
+    /*
+    PoolPrecarga pool(2);
+    ProxySitioWeb enlace("www.sitiopermitido2.com");
+    enlace.precargar(pool);
+    this_thread::sleep_for(chrono::milliseconds(100));
+    enlace.visualizar();
+    */
+
+    // Proxy con cache: la segunda visita no va al servidor
+    /*
+    OrigenSimulado servidor(chrono::milliseconds(200));
+    CacheSitios cache([&servidor](const string& url) { return servidor.cargar(url); },
+                      1000, chrono::minutes(5));
+    ProxySitioWebConCache conCache("www.sitiopermitido1.com", cache);
+    conCache.visualizar();   // tarda 200 ms
+    conCache.visualizar();   // sale de la cache
+    ProxySitioWebConCache("www.sitioprohibido1.com", cache).visualizar();   // sin salida
+    cache.mostrarEstadisticas();
+    medirCacheSitios(8, 100000, 1000, chrono::milliseconds(20));
+    */
+
     /*
     // Ejemplo de uso de Adapter de Pago
 
@@ -2,6 +2,16 @@
 
 #include <iostream>
 #include <vector>
+#include <iterator>  // random_access_iterator
+#include <ranges>
+#include <algorithm>
+#include <compare>   // strong_ordering
+#include <cstddef>   // ptrdiff_t
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "../comun/contador_asignaciones.h"   // asignaciones (para medirIteracion)
 using namespace std;
 
 // Patrón Iterator
@@ -13,36 +23,103 @@ struct Cancion {
         : titulo(t), artista(a) {}
 };
 
-// Iterador generico para recorrer un vector<T>
-template<typename T>
-class Iterador {
+// Iterador que recorre un vector<T> sin copiarlo: solo guarda punteros a
+// sus elementos. Con Paso = 1 va del primero al ultimo y con Paso = -1 al
+// reves. Ademas de la interfaz del patron (*, siguiente, final) cumple
+// random_access_iterator, asi que sirve con los algoritmos y las vistas de
+// std::ranges. Como cualquier iterador de vector, deja de valer si el
+// vector cambia de tamaño.
+template<typename T, int Paso>
+class IteradorLista {
 private:
-    vector<T> db;   // copia del contenedor a iterar
-    int indice;     // posición actual del iterador
+    // Hacia adelante "pos" apunta al elemento actual; hacia atras apunta al
+    // que le sigue al actual (asi nunca queda antes del primero)
+    const T* pos = nullptr;
+    const T* fin = nullptr;
 
 public:
-    Iterador(vector<T> _db)
-        : db(_db), indice(0) {}       // inicializa con índice 0
+    using iterator_concept = random_access_iterator_tag;
+    using iterator_category = random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    IteradorLista() = default;
+
+    IteradorLista(const vector<T>& db)          // empieza en el primero (o el ultimo)
+        : pos(Paso > 0 ? db.data() : db.data() + db.size()),
+          fin(Paso > 0 ? db.data() + db.size() : db.data()) {}
+
+    const T& operator*() const {                // devuelve el elemento actual (sin copiarlo)
+        return Paso > 0 ? *pos : *(pos - 1);
+    }
+
+    void siguiente() {                          // avanza al siguiente elemento
+        pos += Paso;
+    }
 
-    T operator*() {                   // devuelve el elemento actual
-        return db[indice];
+    bool final() const {                        // indica si aún quedan elementos
+        return pos != fin;
     }
 
-    void siguiente() {                // avanza al siguiente elemento
-        indice++;
+    // Copia que termina en "limite": final() da false al llegar ahi
+    IteradorLista hasta(const IteradorLista& limite) const {
+        IteradorLista it = *this;
+        it.fin = limite.pos;
+        return it;
     }
 
-    bool final() {                    // indica si aún quedan elementos
-        return indice < (int)db.size();
+    // Lo que piden los iteradores de la biblioteca estandar
+    const T* operator->() const { return &**this; }
+    const T& operator[](difference_type n) const { return *(*this + n); }
+
+    IteradorLista& operator++() { pos += Paso; return *this; }
+    IteradorLista& operator--() { pos -= Paso; return *this; }
+    IteradorLista operator++(int) { IteradorLista antes = *this; pos += Paso; return antes; }
+    IteradorLista operator--(int) { IteradorLista antes = *this; pos -= Paso; return antes; }
+    IteradorLista& operator+=(difference_type n) { pos += n * Paso; return *this; }
+    IteradorLista& operator-=(difference_type n) { pos -= n * Paso; return *this; }
+
+    friend IteradorLista operator+(IteradorLista it, difference_type n) { return it += n; }
+    friend IteradorLista operator+(difference_type n, IteradorLista it) { return it += n; }
+    friend IteradorLista operator-(IteradorLista it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const IteradorLista& a, const IteradorLista& b) {
+        return (a.pos - b.pos) * Paso;
+    }
+    friend bool operator==(const IteradorLista& a, const IteradorLista& b) {
+        return a.pos == b.pos;
+    }
+    friend strong_ordering operator<=>(const IteradorLista& a, const IteradorLista& b) {
+        return Paso > 0 ? a.pos <=> b.pos : b.pos <=> a.pos;
     }
 };
 
-// Iterador inverso (no implementado aqui D:)
+// Iterador generico para recorrer un vector<T>
 template<typename T>
-class IteradorInv {};
+using Iterador = IteradorLista<T, 1>;
+
+// Iterador inverso: del ultimo al primero
+template<typename T>
+using IteradorInv = IteradorLista<T, -1>;
+
+static_assert(random_access_iterator<Iterador<Cancion>>);
+static_assert(random_access_iterator<IteradorInv<Cancion>>);
+
+
+// Parte seguida de una lista, [inicio, fin), para procesarla por separado
+template<typename T>
+struct Trozo {
+    int numero;               // posicion del trozo en la lista
+    Iterador<T> inicio, fin;
+
+    Iterador<T> cursor() const { return inicio.hasta(fin); }   // recorre solo este trozo
+    Iterador<T> begin() const { return inicio; }
+    Iterador<T> end() const { return fin; }
+    size_t size() const { return fin - inicio; }
+};
 
 
-/*
 // Clase Reproductor que usa el patrón Iterator
 
 template<typename T>
@@ -52,18 +129,155 @@ private:
 
 public:
     void agregarCancion(T c) {        // añade canción al final
-        lista_de_canciones.push_back(c);
+        lista_de_canciones.push_back(std::move(c));
     }
 
-    Iterador<T> inicio() {            // crea iterador al inicio
+    Iterador<T> inicio() const {      // crea iterador al inicio
         return Iterador<T>(lista_de_canciones);
     }
 
-    IteradorInv<T> inicioInv() {      // crea iterador inverso (no implementado D:)
+    IteradorInv<T> inicioInv() const {  // crea iterador inverso (empieza por la ultima)
         return IteradorInv<T>(lista_de_canciones);
     }
+
+    // Para recorrerlo con for (:) y usarlo como rango de std::ranges
+    Iterador<T> begin() const { return inicio(); }
+    Iterador<T> end() const { return inicio() + (ptrdiff_t)lista_de_canciones.size(); }
+    size_t size() const { return lista_de_canciones.size(); }
+
+    // Divide la lista en "cantidad" trozos seguidos de tamaño parecido
+    vector<Trozo<T>> dividir(size_t cantidad) const {
+        cantidad = max<size_t>(1, min(cantidad, size()));
+        vector<Trozo<T>> trozos;
+        for (size_t i = 0; i < cantidad; i++) {
+            trozos.push_back(Trozo<T>{(int)i, begin() + (ptrdiff_t)(size() * i / cantidad),
+                                      begin() + (ptrdiff_t)(size() * (i + 1) / cantidad)});
+        }
+        return trozos;
+    }
 };
-*/
+
+// Procesa la lista por trozos en varios hilos: cada hilo toma el siguiente
+// trozo libre y le aplica "procesar" (que devuelve un R). Los resultados se
+// juntan con "combinar" en el orden de los trozos, asi el resultado es el
+// mismo sin importar que hilo termino primero. Se hacen varios trozos por
+// hilo para que ninguno se quede sin trabajo si un trozo tarda mas.
+template<typename T, typename R, typename Procesar, typename Combinar>
+R procesarEnParalelo(const Reproductor<T>& reproductor, int hilos, R inicial,
+                     Procesar procesar, Combinar combinar, int trozosPorHilo = 8) {
+    hilos = max(hilos, 1);
+    vector<Trozo<T>> trozos = reproductor.dividir((size_t)hilos * trozosPorHilo);
+    vector<R> resultados(trozos.size());
+    atomic<size_t> siguiente{0};
+
+    auto trabajar = [&]() {
+        for (size_t i = siguiente++; i < trozos.size(); i = siguiente++)
+            resultados[i] = procesar(trozos[i]);
+    };
+    vector<thread> trabajadores;
+    for (int h = 1; h < hilos; h++)
+        trabajadores.emplace_back(trabajar);
+    trabajar();                        // este hilo tambien trabaja
+    for (thread& t : trabajadores)
+        t.join();
+
+    R total = std::move(inicial);
+    for (R& r : resultados)
+        total = combinar(std::move(total), std::move(r));
+    return total;
+}
+
+static_assert(ranges::random_access_range<Reproductor<Cancion>>);
+
+// Recorre una lista de "n" canciones como lo hacia el iterador anterior
+// (copia del vector y copia de cada cancion) y con Iterador/IteradorInv
+void medirIteracion(int n) {
+    Reproductor<Cancion> reproductor;
+    for (int i = 0; i < n; i++)
+        reproductor.agregarCancion(Cancion("Cancion numero " + to_string(i),
+                                           "Artista numero " + to_string(i % 1000)));
+
+    size_t letrasCopia = 0, letrasAdelante = 0, letrasAtras = 0;
+    size_t antes = asignaciones;
+    auto t0 = chrono::steady_clock::now();
+    vector<Cancion> copia(reproductor.begin(), reproductor.end());
+    for (int i = 0; i < (int)copia.size(); i++) {
+        Cancion c = copia[i];
+        letrasCopia += c.titulo.size();
+    }
+    auto t1 = chrono::steady_clock::now();
+    size_t asignacionesCopia = asignaciones - antes;
+
+    antes = asignaciones;
+    auto t2 = chrono::steady_clock::now();
+    for (Iterador<Cancion> it = reproductor.inicio(); it.final(); it.siguiente())
+        letrasAdelante += it->titulo.size();
+    for (IteradorInv<Cancion> it = reproductor.inicioInv(); it.final(); it.siguiente())
+        letrasAtras += (*it).titulo.size();
+    auto t3 = chrono::steady_clock::now();
+    size_t asignacionesIterador = asignaciones - antes;
+
+    cout << "Copiando: " << chrono::duration<double, milli>(t1 - t0).count() << " ms, "
+         << asignacionesCopia << " reservas de memoria" << endl;
+    cout << "Iterador + IteradorInv: " << chrono::duration<double, milli>(t3 - t2).count() << " ms, "
+         << asignacionesIterador << " reservas de memoria"
+         << (letrasAdelante == letrasCopia && letrasAtras == letrasCopia ? "" : " (NO COINCIDEN)") << endl;
+}
+
+
+// Trabajo por cancion que solo usa CPU: una "huella" del titulo y artista
+// (hash repetido varias veces)
+uint64_t huellaCancion(const Cancion& c) {
+    uint64_t h = 1469598103934665603ULL;
+    for (int vuelta = 0; vuelta < 50; vuelta++) {
+        for (char ch : c.titulo)
+            h = (h ^ (unsigned char)ch) * 1099511628211ULL;
+        for (char ch : c.artista)
+            h = (h ^ (unsigned char)ch) * 1099511628211ULL;
+    }
+    return h;
+}
+
+// Calcula las huellas de "n" canciones con 1, 2, 4, ... hilos y verifica
+// que el resultado (combinado en orden) sea siempre el mismo
+void medirParalelo(int n) {
+    Reproductor<Cancion> reproductor;
+    for (int i = 0; i < n; i++)
+        reproductor.agregarCancion(Cancion("Cancion numero " + to_string(i),
+                                           "Artista numero " + to_string(i % 1000)));
+
+    // Cada trozo devuelve la combinacion de sus huellas; combinar no es
+    // conmutativo, asi que solo coincide si se respeta el orden
+    auto procesar = [](const Trozo<Cancion>& trozo) {
+        uint64_t h = 0;
+        for (Iterador<Cancion> it = trozo.cursor(); it.final(); it.siguiente())
+            h = h * 31 + huellaCancion(*it);
+        return pair<uint64_t, size_t>(h, trozo.size());
+    };
+    auto combinar = [](pair<uint64_t, size_t> a, pair<uint64_t, size_t> b) {
+        uint64_t potencia = 1;                     // 31^(canciones de b)
+        for (uint64_t base = 31, e = b.second; e > 0; e /= 2, base *= base)
+            if (e % 2)
+                potencia *= base;
+        return pair<uint64_t, size_t>(a.first * potencia + b.first, a.second + b.second);
+    };
+
+    int maximo = max(1, (int)thread::hardware_concurrency());
+    double tiempoUno = 0;
+    uint64_t esperado = 0;
+    for (int hilos = 1; hilos <= maximo; hilos *= 2) {
+        auto t0 = chrono::steady_clock::now();
+        auto [huella, cuantas] = procesarEnParalelo(reproductor, hilos, pair<uint64_t, size_t>(0, 0),
+                                                    procesar, combinar);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        if (hilos == 1) {
+            tiempoUno = segundos;
+            esperado = huella;
+        }
+        cout << hilos << " hilos: " << cuantas / segundos << " canciones/s, "
+             << tiempoUno / segundos << "x" << (huella == esperado ? "" : " (RESULTADO DISTINTO)") << endl;
+    }
+}
 
 
 /*
@@ -234,10 +448,32 @@ int main() {
     reproductor.agregarCancion(Cancion("C2","A2"));
     Iterador<Cancion> it = reproductor.inicio();
     while (it.final()) {
-        Cancion c = *it;
+        const Cancion& c = *it;
         cout << "Reproduciendo: " << c.titulo << " - " << c.artista << endl;
         it.siguiente();
     }
+
+    // Al reves, y con algoritmos y vistas de std::ranges
+    for (IteradorInv<Cancion> inv = reproductor.inicioInv(); inv.final(); inv.siguiente())
+        cout << "Reproduciendo: " << inv->titulo << endl;       // C2, C1
+    for (const Cancion& c : reproductor | views::reverse | views::take(1))
+        cout << "Ultima: " << c.titulo << endl;                   // C2
+    cout << ranges::count_if(reproductor, [](const Cancion& c) { return c.artista == "A1"; }) << endl;
+    medirIteracion(1000000);
+
+    // Procesar por trozos en paralelo (el resultado respeta el orden)
+    vector<string> titulos = procesarEnParalelo(reproductor, 4, vector<string>(),
+        [](const Trozo<Cancion>& trozo) {
+            vector<string> parte;
+            for (Iterador<Cancion> it = trozo.cursor(); it.final(); it.siguiente())
+                parte.push_back(it->titulo);
+            return parte;
+        },
+        [](vector<string> todo, vector<string> parte) {
+            todo.insert(todo.end(), parte.begin(), parte.end());
+            return todo;
+        });                                                        // C1, C2
+    medirParalelo(10000000);
     */
 
     return 0;
@@ -2,93 +2,713 @@
 
 #include <iostream>
 #include <stack>      // Para usar la estructura stack (pila)
+#include <vector>
+#include <random>     // Para las prioridades del treap del editor
+#include <string_view>
+#include <fstream>    // Para validar archivos por bloques
+#include <thread>     // Para validar en paralelo
+#include <chrono>
+#include <bit>        // Para countr_zero
+#include <cstdint>
+#include <cstring>    // Para memcpy
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h> // Instrucciones SSE2 (comparar 16 bytes a la vez)
+#endif
 using namespace std;
 
+// Resultado detallado de validar parentesis
+struct ResultadoParentesis {
+    bool correcto = true;
+    long long posicion = -1;  // byte del primer error (el largo total si falta cerrar)
+    char encontrado = 0;      // caracter encontrado en esa posicion (0 = fin del texto)
+    char esperado = 0;        // cierre esperado (0 = no habia nada abierto)
+};
+
+// Pila de tipos de parentesis guardada en 2 bits por elemento
+// (0 = '(', 1 = '[', 2 = '{'): 32 elementos por palabra de 64 bits
+class PilaParentesis {
+private:
+    vector<uint64_t> palabras;
+    size_t altura = 0;
+
+public:
+    void push(int tipo) {
+        if (altura % 32 == 0 && altura / 32 == palabras.size())
+            palabras.push_back(0);
+        uint64_t& palabra = palabras[altura / 32];
+        int desplazamiento = 2 * (altura % 32);
+        palabra = (palabra & ~(3ULL << desplazamiento)) | ((uint64_t)tipo << desplazamiento);
+        altura++;
+    }
+
+    // Tipo del elemento i (0 = el del fondo)
+    int en(size_t i) const {
+        return (palabras[i / 32] >> (2 * (i % 32))) & 3;
+    }
+
+    int top() const { return en(altura - 1); }
+    void pop() { altura--; }
+    bool empty() const { return altura == 0; }
+    size_t size() const { return altura; }
+};
+
+const char APERTURAS[] = "([{";
+const char CIERRES[] = ")]}";
+
+// Tabla que clasifica cada byte: 1..3 apertura de tipo 0..2,
+// 4..6 cierre de tipo 0..2, 0 si no es parentesis
+struct TablaParentesis {
+    unsigned char clase[256] = {};
+    TablaParentesis() {
+        for (int t = 0; t < 3; t++) {
+            clase[(unsigned char)APERTURAS[t]] = 1 + t;
+            clase[(unsigned char)CIERRES[t]] = 4 + t;
+        }
+    }
+};
+const TablaParentesis TABLA_PARENTESIS;
+
+// Devuelve una mascara con un bit por cada parentesis en p[0..15]
+uint32_t mascaraParentesis(const char* p) {
+#if defined(__SSE2__)
+    // Comparamos los 16 bytes a la vez contra los seis parentesis
+    __m128i bloque = _mm_loadu_si128((const __m128i*)p);
+    __m128i iguales = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bloque, _mm_set1_epi8('(')),
+                     _mm_cmpeq_epi8(bloque, _mm_set1_epi8(')'))),
+        _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bloque, _mm_set1_epi8('[')),
+                         _mm_cmpeq_epi8(bloque, _mm_set1_epi8(']'))),
+            _mm_or_si128(_mm_cmpeq_epi8(bloque, _mm_set1_epi8('{')),
+                         _mm_cmpeq_epi8(bloque, _mm_set1_epi8('}')))));
+    return _mm_movemask_epi8(iguales);
+#else
+    uint32_t mascara = 0;
+    for (int i = 0; i < 16; i++)
+        mascara |= (uint32_t)(TABLA_PARENTESIS.clase[(unsigned char)p[i]] != 0) << i;
+    return mascara;
+#endif
+}
+
+// Validador por bloques: recibe el texto de a pedazos (sin guardarlo) y
+// se detiene en el primer error
+class ValidadorParentesis {
+private:
+    PilaParentesis pila;
+    long long procesados = 0;    // bytes vistos en bloques anteriores
+    ResultadoParentesis resultado;
+
+    // Procesa un parentesis en la posicion absoluta "pos"
+    bool procesarByte(char c, long long pos) {
+        int clase = TABLA_PARENTESIS.clase[(unsigned char)c];
+        if (clase <= 3) {
+            pila.push(clase - 1);
+            return true;
+        }
+        // Es un cierre: debe coincidir con la apertura del tope
+        if (pila.empty() || pila.top() != clase - 4) {
+            resultado.correcto = false;
+            resultado.posicion = pos;
+            resultado.encontrado = c;
+            resultado.esperado = pila.empty() ? 0 : CIERRES[pila.top()];
+            return false;
+        }
+        pila.pop();
+        return true;
+    }
+
+public:
+    // Procesa el siguiente bloque; devuelve false si ya hay un error
+    bool procesar(const char* datos, size_t n) {
+        if (!resultado.correcto)
+            return false;
+        size_t i = 0;
+        // De a 16 bytes: solo miramos los bytes que son parentesis
+        for (; i + 16 <= n; i += 16) {
+            uint32_t mascara = mascaraParentesis(datos + i);
+            while (mascara != 0) {
+                int j = countr_zero(mascara);
+                if (!procesarByte(datos[i + j], procesados + i + j))
+                    return false;
+                mascara &= mascara - 1;          // apagamos el bit procesado
+            }
+        }
+        for (; i < n; i++) {
+            if (TABLA_PARENTESIS.clase[(unsigned char)datos[i]] != 0 &&
+                !procesarByte(datos[i], procesados + i))
+                return false;
+        }
+        procesados += n;
+        return true;
+    }
+
+    // Termina la validacion: si algo quedo abierto es un error al final
+    ResultadoParentesis terminar() {
+        if (resultado.correcto && !pila.empty()) {
+            resultado.correcto = false;
+            resultado.posicion = procesados;
+            resultado.esperado = CIERRES[pila.top()];
+        }
+        return resultado;
+    }
+};
+
+// Valida todo lo que se lea de "entrada" en bloques de "tamBloque" bytes
+ResultadoParentesis validarParentesisFlujo(istream& entrada, size_t tamBloque = 1 << 16) {
+    ValidadorParentesis validador;
+    vector<char> bloque(tamBloque);
+    while (entrada) {
+        entrada.read(bloque.data(), tamBloque);
+        if (!validador.procesar(bloque.data(), entrada.gcount()))
+            break;
+    }
+    return validador.terminar();
+}
+
+// Valida un archivo (por ejemplo de varios GB) sin cargarlo entero
+ResultadoParentesis validarParentesisArchivo(const string& ruta) {
+    ifstream archivo(ruta, ios::binary);
+    if (!archivo)
+        throw runtime_error("No se pudo abrir " + ruta);
+    return validarParentesisFlujo(archivo);
+}
+
+// Resumen de un pedazo: lo que no se pudo emparejar dentro de el
+struct ResumenParentesis {
+    vector<unsigned char> cierres;   // cierres sin apertura (en orden)
+    PilaParentesis aperturas;        // aperturas sin cierre
+    bool error = false;              // hubo un cierre de otro tipo adentro
+};
+
+// Resume un pedazo recorriendolo de a 16 bytes como ValidadorParentesis
+ResumenParentesis resumirParentesis(string_view texto) {
+    ResumenParentesis resumen;
+    // Agrega un parentesis al resumen; false si es un cierre de otro tipo
+    auto agregar = [&resumen](char c) {
+        int clase = TABLA_PARENTESIS.clase[(unsigned char)c];
+        if (clase <= 3) {
+            resumen.aperturas.push(clase - 1);
+        }
+        else if (resumen.aperturas.empty()) {
+            resumen.cierres.push_back(clase - 4);   // se empareja con un pedazo anterior
+        }
+        else if (resumen.aperturas.top() != clase - 4) {
+            resumen.error = true;
+            return false;
+        }
+        else {
+            resumen.aperturas.pop();
+        }
+        return true;
+    };
+
+    const char* datos = texto.data();
+    size_t n = texto.size(), i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint32_t mascara = mascaraParentesis(datos + i);
+        while (mascara != 0) {
+            if (!agregar(datos[i + countr_zero(mascara)]))
+                return resumen;
+            mascara &= mascara - 1;
+        }
+    }
+    for (; i < n; i++) {
+        if (TABLA_PARENTESIS.clase[(unsigned char)datos[i]] != 0 && !agregar(datos[i]))
+            return resumen;
+    }
+    return resumen;
+}
+
+// Valida un texto grande (aunque sea una sola linea) en paralelo: cada hilo
+// resume su pedazo y despues se combinan los resumenes en orden. Si hay un
+// error se repite la validacion secuencial para informar su posicion exacta.
+ResultadoParentesis validarParentesisParalelo(string_view texto, int hilos) {
+    hilos = max(hilos, 1);
+    size_t tamPedazo = (texto.size() + hilos - 1) / hilos;
+    vector<ResumenParentesis> resumenes(hilos);
+    vector<thread> trabajadores;
+    for (int h = 0; h < hilos; h++) {
+        trabajadores.emplace_back([&, h]() {
+            size_t inicio = min(texto.size(), h * tamPedazo);
+            resumenes[h] = resumirParentesis(texto.substr(inicio, tamPedazo));
+        });
+    }
+    for (thread& t : trabajadores)
+        t.join();
+
+    PilaParentesis pila;
+    bool error = false;
+    for (int h = 0; h < hilos && !error; h++) {
+        if (resumenes[h].error) {
+            error = true;
+            break;
+        }
+        for (unsigned char tipo : resumenes[h].cierres) {
+            if (pila.empty() || pila.top() != tipo) {
+                error = true;
+                break;
+            }
+            pila.pop();
+        }
+        for (size_t i = 0; i < resumenes[h].aperturas.size(); i++)
+            pila.push(resumenes[h].aperturas.en(i));
+    }
+
+    if (!error && pila.empty())
+        return ResultadoParentesis();
+    ValidadorParentesis validador;
+    validador.procesar(texto.data(), texto.size());
+    return validador.terminar();
+}
+
+// Mide la validacion secuencial y paralela de "megas" MB de texto valido
+void medirValidador(int megas, int hilos) {
+    // Repetimos un bloque valido con anidamiento y texto entre parentesis
+    string bloque = "{a:[1,(2+3)*4],b:{c:[(x)],d:(y*[z])}}";
+    string texto;
+    texto.reserve(megas * 1000000 + bloque.size());
+    while ((int)texto.size() < megas * 1000000)
+        texto += bloque;
+
+    auto t0 = chrono::steady_clock::now();
+    ValidadorParentesis validador;
+    validador.procesar(texto.data(), texto.size());
+    bool secuencial = validador.terminar().correcto;
+    auto t1 = chrono::steady_clock::now();
+    bool paralelo = validarParentesisParalelo(texto, hilos).correcto;
+    auto t2 = chrono::steady_clock::now();
+
+    double gb = texto.size() / 1e9;
+    cout << "Secuencial: " << gb / chrono::duration<double>(t1 - t0).count() << " GB/s ("
+         << secuencial << "), paralelo con " << hilos << " hilos: "
+         << gb / chrono::duration<double>(t2 - t1).count() << " GB/s (" << paralelo << ")" << endl;
+}
+
 // Funcion que comprueba si los paréntesis en 'operacion' están bien balanceados
-string validarParentesis(string operacion) {
-    stack<char> parentesis;          // Pila para guardar paréntesis de apertura
-    for (char c : operacion) {
-        // Si es paréntesis de apertura, lo apilamos
-        if (c == '(' || c == '{' || c == '[')
-            parentesis.push(c);
-
-        // Si es paréntesis de cierre, validamos contra el tope de la pila
-        if (c == ')' || c == '}' || c == ']') {
-            // 1) Si no hay apertura que hacer pop, la operación es inválida
-            if (parentesis.empty())
-                return "Operacion incorrecta!";
-
-            // 2) Verificamos que el tipo coincida
-            if ((c == ')' && parentesis.top() != '(') ||
-                (c == ']' && parentesis.top() != '[') ||
-                (c == '}' && parentesis.top() != '{'))
-                return "Operacion incorrecta!";
-
-            // 3) Si coincide, quitamos el paréntesis de apertura de la pila
-            parentesis.pop();
-        }
-    }
-    // Si al final queda algún paréntesis sin cerrar, es inválido
-    if (!parentesis.empty())
+string validarParentesis(const string& operacion) {
+    ValidadorParentesis validador;
+    validador.procesar(operacion.data(), operacion.size());
+    if (!validador.terminar().correcto)
         return "Operacion incorrecta!";
-
-    // Si todo está balanceado, es correcto
     return "Operacion correcta";
 }
 
-// Función que convierte un número decimal a cadena binaria usando una pila
-string decimalABinario(int decimal) {
-    stack<int> binario;  // Pila para los dígitos binarios
-    if (decimal == 0)    // Caso base: si es 0, devolvemos "0"
-        return "0";
+// Conversion de enteros de 64 bits a texto en cualquier base de 2 a 36
+
+const char DIGITOS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+const int MAX_CARACTERES = 65;   // signo + 64 digitos binarios
+
+// Tablas para las bases 2 y 16: cada byte se convierte de una sola vez
+// (8 digitos binarios o 2 hexadecimales) en lugar de digito por digito
+struct TablasBase {
+    char binario[256][8];
+    char hexadecimal[256][2];
+    TablasBase() {
+        for (int b = 0; b < 256; b++) {
+            for (int i = 0; i < 8; i++)
+                binario[b][i] = '0' + ((b >> (7 - i)) & 1);
+            hexadecimal[b][0] = DIGITOS[b >> 4];
+            hexadecimal[b][1] = DIGITOS[b & 15];
+        }
+    }
+};
+const TablasBase TABLAS_BASE;
+
+// Escribe "valor" en la base dada en "destino" (que debe tener lugar para
+// MAX_CARACTERES) y devuelve cuantos caracteres escribio. No reserva memoria.
+int formatearEntero(int64_t valor, int base, char* destino) {
+    if (base < 2 || base > 36)
+        throw invalid_argument("formatearEntero: base fuera de [2, 36]");
+    int escritos = 0;
+    // Trabajamos con el valor absoluto sin signo (vale tambien para INT64_MIN)
+    uint64_t u = (uint64_t)valor;
+    if (valor < 0) {
+        destino[escritos++] = '-';
+        u = 0 - u;
+    }
+    if (u == 0) {
+        destino[escritos++] = '0';
+        return escritos;
+    }
+    char* p = destino + escritos;
+
+    if (has_single_bit((unsigned)base)) {
+        // Base potencia de 2: la cantidad de digitos sale de los ceros a la
+        // izquierda y cada digito es un grupo de bits
+        int bitsPorDigito = countr_zero((unsigned)base);
+        int bits = 64 - countl_zero(u);
+        int digitos = (bits + bitsPorDigito - 1) / bitsPorDigito;
+        if (base == 2) {
+            // Primero los bits sueltos del byte mas alto, despues bytes enteros
+            int sueltos = digitos % 8;
+            int i = 0;
+            if (sueltos != 0) {
+                memcpy(p, TABLAS_BASE.binario[(u >> (digitos - sueltos)) & 0xFF] + 8 - sueltos, sueltos);
+                i = sueltos;
+            }
+            for (; i < digitos; i += 8)
+                memcpy(p + i, TABLAS_BASE.binario[(u >> (digitos - i - 8)) & 0xFF], 8);
+        }
+        else if (base == 16) {
+            int i = 0;
+            if (digitos % 2 != 0) {
+                p[0] = DIGITOS[(u >> (4 * (digitos - 1))) & 15];
+                i = 1;
+            }
+            for (; i < digitos; i += 2)
+                memcpy(p + i, TABLAS_BASE.hexadecimal[(u >> (4 * (digitos - i - 2))) & 0xFF], 2);
+        }
+        else {
+            uint64_t mascara = base - 1;
+            for (int i = digitos - 1; i >= 0; i--) {
+                p[i] = DIGITOS[u & mascara];
+                u >>= bitsPorDigito;
+            }
+        }
+        return escritos + digitos;
+    }
+
+    // Otras bases: los digitos salen al reves, los ponemos al final de un
+    // arreglo local y los copiamos al destino
+    char temporal[64];
+    int i = 64;
+    while (u != 0) {
+        temporal[--i] = DIGITOS[u % base];
+        u /= base;
+    }
+    memcpy(p, temporal + i, 64 - i);
+    return escritos + 64 - i;
+}
+
+// Escribe los n valores en "destino" separados por "separador" y devuelve
+// cuantos bytes uso. Lanza length_error si no alcanza la "capacidad".
+size_t formatearEnteros(const int64_t* valores, size_t n, int base,
+                        char* destino, size_t capacidad, char separador = '\n') {
+    size_t usados = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (capacidad - usados >= MAX_CARACTERES + 1) {
+            usados += formatearEntero(valores[i], base, destino + usados);
+        }
+        else {
+            // Cerca del final: formateamos aparte para no pasarnos
+            char temporal[MAX_CARACTERES];
+            int largo = formatearEntero(valores[i], base, temporal);
+            if (capacidad - usados < (size_t)largo + 1)
+                throw length_error("formatearEnteros: el buffer es muy chico");
+            memcpy(destino + usados, temporal, largo);
+            usados += largo;
+        }
+        destino[usados++] = separador;
+    }
+    return usados;
+}
+
+// Valor de un caracter como digito (99 si no es un digito valido)
+int valorDigito(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+    return 99;
+}
+
+// Interpreta "texto" como entero en la base dada. Devuelve false si tiene
+// caracteres invalidos o no entra en 64 bits.
+bool parsearEntero(string_view texto, int base, int64_t& valor) {
+    if (base < 2 || base > 36)
+        throw invalid_argument("parsearEntero: base fuera de [2, 36]");
+    bool negativo = !texto.empty() && texto[0] == '-';
+    if (negativo)
+        texto.remove_prefix(1);
+    if (texto.empty())
+        return false;
+    uint64_t u = 0;
+    uint64_t limite = negativo ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    for (char c : texto) {
+        int d = valorDigito(c);
+        if (d >= base || u > (limite - d) / base)
+            return false;                      // digito invalido o desborde
+        u = u * base + d;
+    }
+    valor = negativo ? (int64_t)(0 - u) : (int64_t)u;
+    return true;
+}
 
-    // Mientras el número sea > 0, obtenemos el bit menos significativo
-    while (decimal > 0) {
-        int digito = decimal % 2;  // 0 o 1
-        binario.push(digito);      // lo apilamos
-        decimal /= 2;              // seguimos con el siguiente bit
+// Lee hasta "maximo" valores separados por "separador" y devuelve cuantos
+// leyo. Lanza invalid_argument si algun valor no es valido.
+size_t parsearEnteros(string_view texto, int base, int64_t* destino,
+                      size_t maximo, char separador = '\n') {
+    size_t leidos = 0;
+    while (!texto.empty() && leidos < maximo) {
+        size_t fin = texto.find(separador);
+        if (!parsearEntero(texto.substr(0, fin), base, destino[leidos]))
+            throw invalid_argument("parsearEnteros: valor invalido: " + string(texto.substr(0, fin)));
+        leidos++;
+        if (fin == string_view::npos)
+            break;
+        texto.remove_prefix(fin + 1);
     }
+    return leidos;
+}
+
+// Función que convierte un número decimal a cadena binaria
+string decimalABinario(long long decimal) {
+    char digitos[MAX_CARACTERES];
+    return string(digitos, formatearEntero(decimal, 2, digitos));
+}
 
-    // Construimos la cadena sacando los bits de la pila (MSB primero)
-    string resultado;
-    while (!binario.empty()) {
-        resultado += to_string(binario.top());
-        binario.pop();
+// Mide cuantos valores por segundo se formatean y se vuelven a leer
+void medirFormateo(int n) {
+    vector<int64_t> valores(n), leidos(n);
+    mt19937_64 gen(7);
+    for (int64_t& v : valores)
+        v = (int64_t)gen() >> (gen() % 64);      // largos variados, con signo
+    vector<char> buffer((size_t)n * (MAX_CARACTERES + 1));
+
+    for (int base : {2, 10, 16, 36}) {
+        auto t0 = chrono::steady_clock::now();
+        size_t usados = formatearEnteros(valores.data(), n, base, buffer.data(), buffer.size());
+        auto t1 = chrono::steady_clock::now();
+        size_t cuantos = parsearEnteros(string_view(buffer.data(), usados - 1), base, leidos.data(), n);
+        auto t2 = chrono::steady_clock::now();
+        cout << "Base " << base << ": formateo "
+             << n / chrono::duration<double>(t1 - t0).count() << " valores/s, lectura "
+             << n / chrono::duration<double>(t2 - t1).count() << " valores/s"
+             << (cuantos == (size_t)n && leidos == valores ? "" : " (NO COINCIDEN)") << endl;
     }
-    return resultado;
 }
 
-// Clase que simula un editor de texto con historial de deshacer
+// Clase que simula un editor de texto con historial de deshacer/rehacer.
+// El texto es una "tabla de piezas": todo lo que se escribe se agrega al
+// final de un buffer que nunca se modifica, y el documento es una secuencia
+// de piezas (trozos de ese buffer). Las piezas se guardan en un arbol
+// balanceado (treap) donde cada nodo conoce la longitud total de su
+// subarbol, asi insertar o borrar en cualquier posicion cuesta O(log n).
+// El historial guarda solo los cambios (posicion y piezas afectadas), no
+// copias del texto completo.
 class EditorTexto {
 private:
-    string texto;            // Contenido actual
-    stack<string> historial; // Pila de estados para deshacer
+    // Trozo del buffer: buffer[inicio, inicio + largo)
+    struct Pieza {
+        size_t inicio, largo;
+    };
+
+    // Nodo del treap de piezas (ordenado por posicion en el documento)
+    struct NodoPieza {
+        Pieza pieza;
+        unsigned prioridad;       // prioridad aleatoria (mantiene el balance)
+        size_t total;             // largo total del texto de este subarbol
+        NodoPieza* left = NULL;
+        NodoPieza* right = NULL;
+        NodoPieza(Pieza p, unsigned prioridad)
+            : pieza(p), prioridad(prioridad), total(p.largo) {}
+    };
+
+    // Un cambio del historial: se insertaron o se borraron estas piezas
+    // a partir de "posicion"
+    struct Cambio {
+        bool esInsercion;
+        size_t posicion;
+        vector<Pieza> piezas;
+    };
+
+    string buffer;               // todo el texto escrito alguna vez (solo crece)
+    NodoPieza* raiz = NULL;
+    stack<Cambio> historial;     // cambios que se pueden deshacer
+    stack<Cambio> rehechos;      // cambios deshechos que se pueden rehacer
+    mt19937 generador;
+
+    static size_t total(NodoPieza* nodo) {
+        return nodo == NULL ? 0 : nodo->total;
+    }
+
+    static void actualizar(NodoPieza* nodo) {
+        nodo->total = total(nodo->left) + nodo->pieza.largo + total(nodo->right);
+    }
+
+    // Une dos treaps (todo "a" va antes que todo "b")
+    static NodoPieza* unir(NodoPieza* a, NodoPieza* b) {
+        if (a == NULL) return b;
+        if (b == NULL) return a;
+        if (a->prioridad > b->prioridad) {
+            a->right = unir(a->right, b);
+            actualizar(a);
+            return a;
+        }
+        b->left = unir(a, b->left);
+        actualizar(b);
+        return b;
+    }
+
+    // Separa el treap en los primeros "pos" caracteres y el resto,
+    // cortando en dos la pieza que contiene la posicion si hace falta
+    void separar(NodoPieza* nodo, size_t pos, NodoPieza*& izq, NodoPieza*& der) {
+        if (nodo == NULL) {
+            izq = der = NULL;
+            return;
+        }
+        size_t antes = total(nodo->left);
+        if (pos <= antes) {
+            separar(nodo->left, pos, izq, nodo->left);
+            actualizar(nodo);
+            der = nodo;
+        }
+        else if (pos >= antes + nodo->pieza.largo) {
+            separar(nodo->right, pos - antes - nodo->pieza.largo, nodo->right, der);
+            actualizar(nodo);
+            izq = nodo;
+        }
+        else {
+            // La posicion cae dentro de esta pieza: la cortamos en dos
+            size_t corte = pos - antes;
+            Pieza resto = {nodo->pieza.inicio + corte, nodo->pieza.largo - corte};
+            nodo->pieza.largo = corte;
+            // El resto hereda la prioridad del nodo cortado: asi puede adoptar
+            // su hijo derecho y quedar colgado de sus ancestros sin romper
+            // la propiedad de heap
+            NodoPieza* nuevo = new NodoPieza(resto, nodo->prioridad);
+            nuevo->right = nodo->right;
+            nodo->right = NULL;
+            actualizar(nuevo);
+            actualizar(nodo);
+            izq = nodo;
+            der = nuevo;
+        }
+    }
+
+    // Guarda en "piezas" las piezas del subarbol en orden y libera sus nodos
+    static void extraer(NodoPieza* nodo, vector<Pieza>& piezas) {
+        if (nodo == NULL)
+            return;
+        extraer(nodo->left, piezas);
+        piezas.push_back(nodo->pieza);
+        extraer(nodo->right, piezas);
+        delete nodo;
+    }
+
+    static void liberar(NodoPieza* nodo) {
+        if (nodo == NULL)
+            return;
+        liberar(nodo->left);
+        liberar(nodo->right);
+        delete nodo;
+    }
+
+    static void copiarTexto(NodoPieza* nodo, const string& buffer, string& texto) {
+        if (nodo == NULL)
+            return;
+        copiarTexto(nodo->left, buffer, texto);
+        texto.append(buffer, nodo->pieza.inicio, nodo->pieza.largo);
+        copiarTexto(nodo->right, buffer, texto);
+    }
+
+    // Inserta las piezas (en orden) a partir de "pos"
+    void insertarPiezas(size_t pos, const vector<Pieza>& piezas) {
+        NodoPieza *izq, *der;
+        separar(raiz, pos, izq, der);
+        for (const Pieza& p : piezas)
+            izq = unir(izq, new NodoPieza(p, generador()));
+        raiz = unir(izq, der);
+    }
+
+    // Quita "largo" caracteres desde "pos" y devuelve las piezas quitadas
+    vector<Pieza> quitarPiezas(size_t pos, size_t largo) {
+        NodoPieza *izq, *medio, *der;
+        separar(raiz, pos, izq, der);
+        separar(der, largo, medio, der);
+        vector<Pieza> piezas;
+        extraer(medio, piezas);
+        raiz = unir(izq, der);
+        return piezas;
+    }
+
+    // Aplica un cambio (o su inverso si "invertir")
+    void aplicar(const Cambio& cambio, bool invertir) {
+        if (cambio.esInsercion != invertir) {
+            insertarPiezas(cambio.posicion, cambio.piezas);
+        }
+        else {
+            size_t largo = 0;
+            for (const Pieza& p : cambio.piezas)
+                largo += p.largo;
+            quitarPiezas(cambio.posicion, largo);
+        }
+    }
+
+    // Registra un cambio nuevo (ya no se puede rehacer lo deshecho)
+    void registrar(Cambio cambio) {
+        historial.push(std::move(cambio));
+        rehechos = stack<Cambio>();
+    }
 
 public:
-    // Añade texto al final y guarda el nuevo estado en el historial
+    EditorTexto() : generador(12345) {}
+
+    EditorTexto(const EditorTexto&) = delete;
+    EditorTexto& operator=(const EditorTexto&) = delete;
+
+    ~EditorTexto() {
+        liberar(raiz);
+    }
+
+    // Inserta "entrada" en la posicion "pos" (0 = al inicio)
+    void insertar(size_t pos, const string& entrada) {
+        if (entrada.empty())
+            return;
+        pos = min(pos, size());
+        Pieza nueva = {buffer.size(), entrada.size()};
+        buffer += entrada;                 // solo crece con lo que se escribe
+        Cambio cambio = {true, pos, {nueva}};
+        aplicar(cambio, false);
+        registrar(std::move(cambio));
+    }
+
+    // Borra "largo" caracteres desde la posicion "pos"
+    void borrar(size_t pos, size_t largo) {
+        if (pos >= size())
+            return;
+        largo = min(largo, size() - pos);
+        if (largo == 0)
+            return;
+        // Las piezas borradas siguen en el buffer: guardamos solo sus limites
+        registrar(Cambio{false, pos, quitarPiezas(pos, largo)});
+    }
+
+    // Añade texto al final
     void agregarTexto(string entrada) {
-        texto += entrada;       // Concatenamos la nueva entrada
-        historial.push(texto);  // Guardamos el estado actualizado
+        insertar(size(), entrada);
     }
 
     // Devuelve el texto actual
     string getTexto() {
+        string texto;
+        texto.reserve(size());
+        copiarTexto(raiz, buffer, texto);
         return texto;
     }
 
-    // Deshace el último cambio restaurando el estado anterior
+    // Devuelve la cantidad de caracteres del texto
+    size_t size() {
+        return total(raiz);
+    }
+
+    // Deshace el último cambio aplicando su inverso
     void deshacer() {
-        if (historial.size() > 1) {
-            historial.pop();           // Quitamos el estado actual
-            texto = historial.top();   // Restauramos el anterior
-        } else if (!historial.empty()) {
-            // Si solo quedaba un estado, lo borramos y dejamos texto vacío
-            historial.pop();
-            texto = "";
-        }
+        if (historial.empty())
+            return;
+        aplicar(historial.top(), true);
+        rehechos.push(std::move(historial.top()));
+        historial.pop();
     }
 
-    // Nota: no existe un método 'rehacer' en esta clase
+    // Vuelve a aplicar el último cambio deshecho
+    void rehacer() {
+        if (rehechos.empty())
+            return;
+        aplicar(rehechos.top(), false);
+        historial.push(std::move(rehechos.top()));
+        rehechos.pop();
+    }
 };
 
 int main() {
@@ -108,13 +728,29 @@ int main() {
     editor.deshacer();                     // Deshacemos "Mundo "
     cout << editor.getTexto() << endl;     // Salida: Hola
 
-    // editor.rehacer();                   // ERROR: método no implementado
+    editor.rehacer();                      // Rehacemos "Mundo "
+    cout << editor.getTexto() << endl;     // Salida: Hola Mundo
+
+    editor.insertar(5, "gran ");           // Insertamos en medio
+    cout << editor.getTexto() << endl;     // Salida: Hola gran Mundo
+    editor.borrar(0, 5);                   // Borramos "Hola "
+    cout << editor.getTexto() << endl;     // Salida: gran Mundo
+    editor.deshacer();                     // Vuelve "Hola "
+    cout << editor.getTexto() << endl;     // Salida: Hola gran Mundo
 
     // --- Ejemplo de decimalABinario ---
     /*
     int decimal = 42;
     string binario = decimalABinario(decimal);
     cout << decimal << " -> " << binario << endl; // 42 -> 101010
+    cout << decimalABinario(-5) << endl;          // -101
+
+    // Formateo de muchos valores en un buffer propio (sin reservar memoria)
+    int64_t valores[] = {255, -255, INT64_MIN};
+    char buffer[3 * (MAX_CARACTERES + 1)];
+    size_t usados = formatearEnteros(valores, 3, 16, buffer, sizeof(buffer), ' ');
+    cout << string(buffer, usados) << endl;       // ff -ff -8000000000000000
+    medirFormateo(1000000);
     */
 
     // --- Ejemplo de validarParentesis ---
@@ -123,6 +759,18 @@ int main() {
     cout << validarParentesis("{1+[1-(3*4}/7]") << endl; // Operacion incorrecta!
     cout << validarParentesis("[1+(5*2)]") << endl;      // Operacion correcta
     cout << validarParentesis("[1+(5*2)") << endl;       // Operacion incorrecta
+
+    // Con el detalle del primer error
+    ValidadorParentesis validador;
+    string operacion = "{1+[1-(3*4}/7]";
+    validador.procesar(operacion.data(), operacion.size());
+    ResultadoParentesis r = validador.terminar();
+    cout << "Error en el byte " << r.posicion << ": se encontro '" << r.encontrado
+         << "' y se esperaba '" << r.esperado << "'" << endl;  // byte 10, '}' y ')'
+
+    // Validacion de un archivo grande y comparacion secuencial/paralela
+    // cout << validarParentesisArchivo("datos.json").correcto << endl;
+    medirValidador(500, thread::hardware_concurrency());
     */
 
     return 0;
@@ -2,14 +2,138 @@
 
 #include <iostream>
 #include <queue>      // para usar colas (queue y priority_queue)
-#include <thread>     // para pausas con sleep_for
+#include <thread>     // para pausas con sleep_for y los hilos del banco
+#include <atomic>     // para la cola sin locks
+#include <memory>     // para unique_ptr
+#include <vector>
+#include <algorithm>  // para nth_element
+#include <bit>        // para bit_ceil
+#include <chrono>
+#include <cstdint>
+#include <deque>      // colas de cada trabajador del planificador
+#include <mutex>
+#include <condition_variable>
+#include <functional> // para function (trabajo de una Tarea)
+#include <random>     // para la comparacion de temporizadores
+#include <concepts>   // para same_as
+#include <fstream>    // para escribir los lotes de impresion
+#include <filesystem> // para crear el directorio de salida
 using namespace std;
 
+// Cola sobre un arreglo circular contiguo. Cada elemento tiene un numero
+// de secuencia absoluto (el primero que entro es el 0) y vive en la celda
+// secuencia % capacidad. Permite recorrerla sin copiarla con una Vista.
+template<typename T>
+class ColaCircular {
+private:
+    vector<T> datos;          // capacidad potencia de 2
+    uint64_t inicio = 0;      // secuencia del primero en la cola
+    uint64_t fin = 0;         // secuencia que recibira el proximo en entrar
+
+    T& celda(uint64_t secuencia) {
+        return datos[secuencia & (datos.size() - 1)];
+    }
+
+    // Duplica la capacidad: cada elemento pasa a la celda de su secuencia
+    void crecer() {
+        vector<T> nuevos(max((size_t)8, 2 * datos.size()));
+        for (uint64_t s = inicio; s < fin; s++)
+            nuevos[s & (nuevos.size() - 1)] = std::move(celda(s));
+        datos.swap(nuevos);
+    }
+
+public:
+    // Recorre los elementos con secuencia en [desde, hasta) sin copiarlos
+    class Iterador {
+    private:
+        const ColaCircular* cola;
+        uint64_t secuencia;
+
+    public:
+        Iterador(const ColaCircular* cola, uint64_t secuencia)
+            : cola(cola), secuencia(secuencia) {}
+
+        const T& operator*() const { return cola->en(secuencia); }
+        Iterador& operator++() { secuencia++; return *this; }
+        bool operator!=(const Iterador& otro) const { return secuencia != otro.secuencia; }
+        uint64_t getSecuencia() const { return secuencia; }
+    };
+
+    // Foto de la cola en un momento: los elementos con secuencia en
+    // [desde, hasta). Nadie modifica esos elementos mientras estan en la
+    // cola, asi que la vista sigue siendo consistente aunque despues entren
+    // otros (incluso si el arreglo crece). Los que ya salieron se saltan.
+    class Vista {
+    private:
+        const ColaCircular* cola;
+        uint64_t desde, hasta;
+
+    public:
+        Vista(const ColaCircular* cola, uint64_t desde, uint64_t hasta)
+            : cola(cola), desde(desde), hasta(hasta) {}
+
+        Iterador begin() const {
+            return Iterador(cola, min(hasta, max(desde, cola->inicio)));
+        }
+        Iterador end() const {
+            return Iterador(cola, hasta);
+        }
+
+        // Secuencia del primer elemento de la foto
+        uint64_t getDesde() const { return desde; }
+
+        // Cantidad de elementos de la foto que siguen en la cola
+        size_t size() const {
+            uint64_t primero = max(desde, cola->inicio);
+            return primero < hasta ? hasta - primero : 0;
+        }
+
+        // Sub-vista con "cuantos" elementos desde la posicion "posicion"
+        // (0 = el primero de la foto)
+        Vista pagina(size_t posicion, size_t cuantos) const {
+            uint64_t a = min(hasta, desde + posicion);
+            uint64_t b = min(hasta, a + cuantos);
+            return Vista(cola, a, b);
+        }
+    };
+
+    void push(T valor) {
+        if (fin - inicio == datos.size())
+            crecer();
+        celda(fin++) = std::move(valor);
+    }
+
+    void pop() {
+        celda(inicio++) = T();        // liberamos lo que ocupaba el elemento
+    }
+
+    const T& front() const { return en(inicio); }
+    bool empty() const { return inicio == fin; }
+    size_t size() const { return fin - inicio; }
+
+    // Elemento con la secuencia dada (debe seguir en la cola)
+    const T& en(uint64_t secuencia) const {
+        return datos[secuencia & (datos.size() - 1)];
+    }
+
+    // Foto de todos los elementos que hay ahora en la cola
+    Vista vista() const {
+        return Vista(this, inicio, fin);
+    }
+};
+
 // Clase que simula un banco con dos colas: normal y de prioridad
 class Banco {
 private:
-    queue<string> lista_clientes;    // clientes sin prioridad
-    queue<string> lista_prioridad;   // clientes con prioridad
+    ColaCircular<string> lista_clientes;    // clientes sin prioridad
+    ColaCircular<string> lista_prioridad;   // clientes con prioridad
+
+    // Muestra los clientes de la vista con su posicion en la cola
+    // ("primero" es la posicion del primero de la vista)
+    static void mostrar(const ColaCircular<string>::Vista& vista, size_t primero) {
+        for (const string& cliente : vista)
+            cout << primero++ << ": " << cliente << endl;
+    }
 
 public:
     // El cliente saca un ticket normal
@@ -22,26 +146,31 @@ public:
         lista_prioridad.push(nombre);
     }
 
-    // Muestra quiénes están esperando en ambas colas
+    // Muestra quiénes están esperando en ambas colas (sin copiarlas)
     void mostrarClientesEnEspera() {
-        // Usamos copias para no vaciar las colas originales
-        queue<string> copia = lista_clientes;
         cout << "Lista de clientes:" << endl;
-        int i = 1;
-        while (!copia.empty()) {
-            cout << i << ": " << copia.front() << endl; // muestra el cliente al frente
-            copia.pop();                                  // quita de la copia
-            i++;
-        }
+        mostrar(lista_clientes.vista(), 1);
+        cout << "Lista de prioridad:" << endl;
+        mostrar(lista_prioridad.vista(), 1);
+    }
 
-        queue<string> copia2 = lista_prioridad;
+    // Muestra solo las posiciones [desde, hasta] de cada cola (desde 1)
+    void mostrarClientesEnEspera(size_t desde, size_t hasta) {
+        if (desde < 1 || hasta < desde)
+            return;
+        cout << "Lista de clientes:" << endl;
+        mostrar(lista_clientes.vista().pagina(desde - 1, hasta - desde + 1), desde);
         cout << "Lista de prioridad:" << endl;
-        int j = 1;
-        while (!copia2.empty()) {
-            cout << j << ": " << copia2.front() << endl;
-            copia2.pop();
-            j++;
-        }
+        mostrar(lista_prioridad.vista().pagina(desde - 1, hasta - desde + 1), desde);
+    }
+
+    // Fotos de las colas para recorrerlas sin copiarlas
+    ColaCircular<string>::Vista vistaClientes() const {
+        return lista_clientes.vista();
+    }
+
+    ColaCircular<string>::Vista vistaPrioridad() const {
+        return lista_prioridad.vista();
     }
 
     // Atiende al siguiente cliente: primero prioridad, luego normal
@@ -57,16 +186,379 @@ public:
     }
 };
 
+// Cola acotada para varios productores y varios consumidores sin locks.
+// Es un arreglo circular donde cada celda tiene un numero de secuencia que
+// indica si esta libre para la vuelta actual (secuencia == posicion) o ya
+// tiene un dato listo para leer (secuencia == posicion + 1). Productores y
+// consumidores solo compiten por avanzar su indice con compare_exchange.
+template<typename T>
+class ColaMPMC {
+private:
+    struct Celda {
+        atomic<size_t> secuencia;
+        T dato;
+    };
+
+    unique_ptr<Celda[]> celdas;
+    size_t mascara;                          // capacidad - 1 (potencia de 2)
+    alignas(64) atomic<size_t> cabeza{0};    // proxima posicion a escribir
+    alignas(64) atomic<size_t> cola{0};      // proxima posicion a leer
+
+public:
+    // La capacidad se redondea a la siguiente potencia de 2
+    ColaMPMC(size_t capacidad) {
+        size_t tam = bit_ceil(max(capacidad, (size_t)2));
+        celdas.reset(new Celda[tam]);
+        mascara = tam - 1;
+        for (size_t i = 0; i < tam; i++)
+            celdas[i].secuencia.store(i, memory_order_relaxed);
+    }
+
+    // Agrega un elemento; devuelve false si la cola esta llena
+    bool encolar(T valor) {
+        size_t pos = cabeza.load(memory_order_relaxed);
+        Celda* celda;
+        while (true) {
+            celda = &celdas[pos & mascara];
+            size_t secuencia = celda->secuencia.load(memory_order_acquire);
+            intptr_t diferencia = (intptr_t)secuencia - (intptr_t)pos;
+            if (diferencia == 0) {
+                // Celda libre: intentamos reservarla avanzando la cabeza
+                if (cabeza.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                    break;
+            }
+            else if (diferencia < 0) {
+                return false;                // la celda aun no se leyo: llena
+            }
+            else {
+                pos = cabeza.load(memory_order_relaxed);   // otro productor gano
+            }
+        }
+        celda->dato = std::move(valor);
+        celda->secuencia.store(pos + 1, memory_order_release);   // dato listo
+        return true;
+    }
+
+    // Saca el elemento mas antiguo; devuelve false si la cola esta vacia
+    bool desencolar(T& valor) {
+        size_t pos = cola.load(memory_order_relaxed);
+        Celda* celda;
+        while (true) {
+            celda = &celdas[pos & mascara];
+            size_t secuencia = celda->secuencia.load(memory_order_acquire);
+            intptr_t diferencia = (intptr_t)secuencia - (intptr_t)(pos + 1);
+            if (diferencia == 0) {
+                if (cola.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                    break;
+            }
+            else if (diferencia < 0) {
+                return false;                // nadie escribio aun: vacia
+            }
+            else {
+                pos = cola.load(memory_order_relaxed);
+            }
+        }
+        valor = std::move(celda->dato);
+        // Liberamos la celda para la siguiente vuelta del arreglo
+        celda->secuencia.store(pos + mascara + 1, memory_order_release);
+        return true;
+    }
+};
+
+// Ticket de un cliente con el momento en que lo saco
+struct Ticket {
+    string nombre;
+    bool prioridad;
+    chrono::steady_clock::time_point llegada;
+};
+
+// Banco para varios kioscos (productores) y varios cajeros (consumidores)
+// a la vez, con la misma regla que Banco: primero los de prioridad
+class BancoConcurrente {
+private:
+    ColaMPMC<Ticket> lista_clientes;     // clientes sin prioridad
+    ColaMPMC<Ticket> lista_prioridad;    // clientes con prioridad
+
+public:
+    BancoConcurrente(size_t capacidad)
+        : lista_clientes(capacidad), lista_prioridad(capacidad) {}
+
+    // El cliente saca un ticket normal (false si la cola esta llena)
+    bool sacarticket(string nombre) {
+        return lista_clientes.encolar(Ticket{std::move(nombre), false, chrono::steady_clock::now()});
+    }
+
+    // El cliente saca un ticket de prioridad (false si la cola esta llena)
+    bool sacarticket_con_prioridad(string nombre) {
+        return lista_prioridad.encolar(Ticket{std::move(nombre), true, chrono::steady_clock::now()});
+    }
+
+    // Un cajero toma al siguiente cliente: primero prioridad, luego normal.
+    // Devuelve false si no hay nadie esperando.
+    bool atenderCliente(Ticket& ticket) {
+        return lista_prioridad.desencolar(ticket) || lista_clientes.desencolar(ticket);
+    }
+};
+
+// Simula "kioscos" hilos que emiten "ticketsPorKiosco" tickets cada uno
+// (1 de cada 10 con prioridad) y "cajeros" hilos que los atienden.
+// Muestra tickets por segundo y el percentil 99 de la espera.
+void simularBanco(int kioscos, int cajeros, int ticketsPorKiosco) {
+    BancoConcurrente banco(1024);
+    long long total = (long long)kioscos * ticketsPorKiosco;
+    atomic<long long> atendidos{0};
+    vector<vector<double>> esperas(cajeros);        // microsegundos, por cajero
+    vector<vector<double>> esperasPrioridad(cajeros);
+
+    auto inicio = chrono::steady_clock::now();
+    vector<thread> hilos;
+    for (int k = 0; k < kioscos; k++) {
+        hilos.emplace_back([&, k]() {
+            for (int i = 0; i < ticketsPorKiosco; i++) {
+                string nombre = "K" + to_string(k) + "-" + to_string(i);
+                bool prioridad = i % 10 == 0;
+                // Si la cola esta llena el kiosco espera su turno
+                while (!(prioridad ? banco.sacarticket_con_prioridad(nombre)
+                                   : banco.sacarticket(nombre)))
+                    this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < cajeros; c++) {
+        hilos.emplace_back([&, c]() {
+            Ticket ticket;
+            while (atendidos.load(memory_order_relaxed) < total) {
+                if (!banco.atenderCliente(ticket)) {
+                    this_thread::yield();
+                    continue;
+                }
+                atendidos.fetch_add(1, memory_order_relaxed);
+                double espera = chrono::duration<double, micro>(
+                    chrono::steady_clock::now() - ticket.llegada).count();
+                esperas[c].push_back(espera);
+                if (ticket.prioridad)
+                    esperasPrioridad[c].push_back(espera);
+            }
+        });
+    }
+    for (thread& h : hilos)
+        h.join();
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    // Percentil 99 de todas las esperas juntas
+    auto p99 = [](vector<vector<double>>& porCajero) {
+        vector<double> todas;
+        for (auto& v : porCajero)
+            todas.insert(todas.end(), v.begin(), v.end());
+        if (todas.empty())
+            return 0.0;
+        size_t k = todas.size() * 99 / 100;
+        nth_element(todas.begin(), todas.begin() + k, todas.end());
+        return todas[k];
+    };
+    cout << kioscos << " kioscos, " << cajeros << " cajeros: "
+         << total / segundos << " tickets/s, p99 espera " << p99(esperas)
+         << " us (prioridad: " << p99(esperasPrioridad) << " us)" << endl;
+}
+
 // Representa un documento para una cola de impresión (nombre y fecha)
 struct Documento {
     string nombre, fecha;
     Documento(string n, string f): nombre(n), fecha(f) {}
+    Documento() {}
+};
+
+// Cola acotada que bloquea: "push" espera si esta llena (asi el que produce
+// no puede adelantarse demasiado) y "pop" espera si esta vacia. Al cerrarla
+// "pop" devuelve false cuando ya no queda nada.
+template<typename T>
+class ColaBloqueante {
+private:
+    deque<T> elementos;
+    size_t capacidad;
+    bool cerrada = false;
+    mutex candado;
+    condition_variable hayLugar, hayElementos;
+
+public:
+    ColaBloqueante(size_t capacidad) : capacidad(capacidad) {}
+
+    // Espera lugar y agrega; false si la cola se cerro (el valor se descarta)
+    bool push(T valor) {
+        unique_lock<mutex> lock(candado);
+        hayLugar.wait(lock, [this]() { return elementos.size() < capacidad || cerrada; });
+        if (cerrada)
+            return false;
+        elementos.push_back(std::move(valor));
+        hayElementos.notify_one();
+        return true;
+    }
+
+    bool pop(T& valor) {
+        unique_lock<mutex> lock(candado);
+        hayElementos.wait(lock, [this]() { return !elementos.empty() || cerrada; });
+        if (elementos.empty())
+            return false;
+        valor = std::move(elementos.front());
+        elementos.pop_front();
+        hayLugar.notify_one();
+        return true;
+    }
+
+    // Saca sin esperar todo lo que haya (hasta "maximo") y lo agrega a "lote"
+    size_t popTodos(vector<T>& lote, size_t maximo) {
+        lock_guard<mutex> lock(candado);
+        size_t sacados = 0;
+        while (!elementos.empty() && sacados < maximo) {
+            lote.push_back(std::move(elementos.front()));
+            elementos.pop_front();
+            sacados++;
+        }
+        hayLugar.notify_all();
+        return sacados;
+    }
+
+    void cerrar() {
+        lock_guard<mutex> lock(candado);
+        cerrada = true;
+        hayElementos.notify_all();
+        hayLugar.notify_all();             // los push que esperaban lugar fallan
+    }
+};
+
+// Cola de impresion en tres etapas que corren a la vez:
+//  1) imprimir() deja el documento en una cola acotada (si esta llena espera)
+//  2) varios hilos "renderizan" los documentos en paralelo
+//  3) un hilo junta los documentos listos en lotes y escribe cada lote en
+//     el directorio de salida (la "impresora") con una sola escritura
+class ColaImpresion {
+private:
+    struct Trabajo {
+        Documento documento;
+        chrono::steady_clock::time_point llegada;
+    };
+
+    struct Renderizado {
+        string datos;
+        chrono::steady_clock::time_point llegada;
+    };
+
+    string directorio;
+    ColaBloqueante<Trabajo> entrada;
+    ColaBloqueante<Renderizado> salida;
+    vector<thread> renderizadores;
+    thread impresora;
+    vector<double> latencias;          // ms desde imprimir() hasta quedar escrito
+    size_t lotes = 0;
+    size_t lotesFallidos = 0;          // lotes que no se pudieron escribir
+    size_t documentosPerdidos = 0;     // documentos de esos lotes
+    chrono::steady_clock::time_point inicio;
+    chrono::steady_clock::time_point fin;
+    bool terminada = false;
+
+    // Simula el trabajo de preparar el documento para la impresora
+    static string renderizar(const Documento& d) {
+        string datos = "=== " + d.nombre + " (" + d.fecha + ") ===\n";
+        for (int linea = 1; linea <= 20; linea++) {
+            datos += "Linea " + to_string(linea) + " de " + d.nombre + "\n";
+        }
+        return datos;
+    }
+
+    void renderizarDocumentos() {
+        Trabajo trabajo;
+        while (entrada.pop(trabajo))
+            salida.push(Renderizado{renderizar(trabajo.documento), trabajo.llegada});
+    }
+
+    // Junta lo que este listo (hasta 256 documentos) y lo escribe de una vez
+    void escribirLotes() {
+        Renderizado primero;
+        vector<Renderizado> lote;
+        string buffer;
+        while (salida.pop(primero)) {
+            lote.clear();
+            lote.push_back(std::move(primero));
+            salida.popTodos(lote, 255);
+
+            buffer.clear();
+            for (Renderizado& r : lote)
+                buffer += r.datos;
+            string ruta = directorio + "/lote_" + to_string(++lotes) + ".prn";
+            ofstream archivo(ruta, ios::binary);
+            archivo.write(buffer.data(), buffer.size());
+            archivo.close();
+            if (!archivo) {
+                // No se pudo abrir o escribir (disco lleno, sin permisos...)
+                lotesFallidos++;
+                documentosPerdidos += lote.size();
+                continue;
+            }
+
+            auto ahora = chrono::steady_clock::now();
+            for (Renderizado& r : lote)
+                latencias.push_back(chrono::duration<double, milli>(ahora - r.llegada).count());
+        }
+    }
+
+public:
+    ColaImpresion(const string& directorio, int hilos = 4, size_t capacidad = 1024)
+        : directorio(directorio), entrada(capacidad), salida(capacidad) {
+        filesystem::create_directories(directorio);
+        inicio = chrono::steady_clock::now();
+        for (int i = 0; i < max(hilos, 1); i++)
+            renderizadores.emplace_back(&ColaImpresion::renderizarDocumentos, this);
+        impresora = thread(&ColaImpresion::escribirLotes, this);
+    }
+
+    ~ColaImpresion() {
+        terminar();
+    }
+
+    // Manda un documento a imprimir (espera si la cola de entrada esta llena);
+    // false si la cola ya se termino
+    bool imprimir(Documento d) {
+        return entrada.push(Trabajo{std::move(d), chrono::steady_clock::now()});
+    }
+
+    // Espera a que se impriman todos los documentos enviados
+    void terminar() {
+        if (terminada)
+            return;
+        terminada = true;
+        entrada.cerrar();
+        for (thread& t : renderizadores)
+            t.join();
+        salida.cerrar();
+        impresora.join();
+        fin = chrono::steady_clock::now();
+    }
+
+    // Muestra documentos por segundo y percentiles de latencia (tras terminar)
+    void mostrarEstadisticas() {
+        if (lotesFallidos > 0)
+            cout << lotesFallidos << " lotes no se pudieron escribir ("
+                 << documentosPerdidos << " documentos perdidos)" << endl;
+        if (latencias.empty())
+            return;
+        vector<double> orden = latencias;
+        sort(orden.begin(), orden.end());
+        auto percentil = [&orden](int p) {
+            return orden[min(orden.size() - 1, orden.size() * p / 100)];
+        };
+        double segundos = chrono::duration<double>(fin - inicio).count();
+        cout << orden.size() << " documentos en " << lotes - lotesFallidos << " lotes, "
+             << orden.size() / segundos << " documentos/s, latencia p50 "
+             << percentil(50) << " ms, p95 " << percentil(95) << " ms, p99 "
+             << percentil(99) << " ms" << endl;
+    }
 };
 
 // Representa una tarea con una prioridad (para priority_queue)
 struct Tarea {
     string nombre;
     int prioridad;
+    function<void()> trabajo = nullptr;   // lo que hay que hacer (opcional)
 
     // Definimos el operador < para que las de mayor prioridad salgan primero
     bool operator<(const Tarea& t) const {
@@ -80,28 +572,669 @@ ostream& operator<<(ostream& os, const Tarea& d) {
     return os;
 }
 
-// Gestor de tareas que utiliza una cola de prioridad
+// Identifica una tarea dentro del Gestor para cambiarla o cancelarla.
+// La generacion evita confundirla con otra tarea que reuse su lugar.
+struct ManejadorTarea {
+    uint32_t indice = UINT32_MAX;
+    uint32_t generacion = 0;
+};
+
+// Gestor de tareas con una cola de prioridad propia: un heap 4-ario que
+// recuerda la posicion de cada tarea, asi se puede cambiar su prioridad o
+// cancelarla en O(log n) sin dejar entradas basura en la cola.
+// Con envejecimiento, cada "envejecimiento" tareas atendidas las que siguen
+// esperando suben un nivel de prioridad: como todas envejecen al mismo
+// ritmo basta ordenar por prioridad * envejecimiento - momento de llegada.
 class Gestor {
 private:
-    priority_queue<Tarea> pq; // la tarea con mayor prioridad está arriba
+    // Lugar de una tarea (los lugares libres se reusan)
+    struct Entrada {
+        Tarea tarea;
+        long long llegada;        // tareas atendidas cuando llego
+        long long orden;          // numero de llegada (desempata: la mas antigua primero)
+        long long clave;          // prioridad efectiva
+        size_t posicion;          // posicion en el heap
+        uint32_t generacion = 0;  // cambia cada vez que el lugar se libera
+    };
+
+    vector<Entrada> entradas;
+    vector<uint32_t> libres;      // lugares libres en "entradas"
+    vector<uint32_t> heap;        // indices de entradas, la mas urgente arriba
+    int envejecimiento;           // 0 = sin envejecimiento
+    long long atendidas = 0;
+    long long llegadas = 0;
+
+    long long calcularClave(int prioridad, long long llegada) {
+        if (envejecimiento == 0)
+            return prioridad;
+        return (long long)prioridad * envejecimiento - llegada;
+    }
+
+    // Indica si la entrada a debe salir antes que la b
+    bool antes(uint32_t a, uint32_t b) {
+        if (entradas[a].clave != entradas[b].clave)
+            return entradas[a].clave > entradas[b].clave;
+        return entradas[a].orden < entradas[b].orden;
+    }
+
+    void poner(size_t pos, uint32_t e) {
+        heap[pos] = e;
+        entradas[e].posicion = pos;
+    }
+
+    void subir(size_t pos) {
+        uint32_t e = heap[pos];
+        while (pos > 0) {
+            size_t padre = (pos - 1) / 4;
+            if (!antes(e, heap[padre]))
+                break;
+            poner(pos, heap[padre]);
+            pos = padre;
+        }
+        poner(pos, e);
+    }
+
+    void bajar(size_t pos) {
+        uint32_t e = heap[pos];
+        while (true) {
+            size_t mejor = pos;
+            uint32_t candidato = e;
+            // El hijo mas urgente de los (hasta) 4
+            for (size_t h = 4 * pos + 1; h <= 4 * pos + 4 && h < heap.size(); h++) {
+                if (antes(heap[h], candidato)) {
+                    mejor = h;
+                    candidato = heap[h];
+                }
+            }
+            if (mejor == pos)
+                break;
+            poner(pos, candidato);
+            pos = mejor;
+        }
+        poner(pos, e);
+    }
+
+    // Saca la entrada del heap y libera su lugar
+    void quitar(uint32_t e) {
+        size_t pos = entradas[e].posicion;
+        uint32_t ultimo = heap.back();
+        heap.pop_back();
+        if (ultimo != e) {
+            poner(pos, ultimo);
+            subir(pos);
+            bajar(entradas[ultimo].posicion);
+        }
+        entradas[e].tarea = Tarea();       // liberamos su memoria ya
+        entradas[e].generacion++;          // los manejadores viejos dejan de valer
+        libres.push_back(e);
+    }
+
+    bool valido(ManejadorTarea m) {
+        return m.indice < entradas.size() && entradas[m.indice].generacion == m.generacion
+            && entradas[m.indice].posicion < heap.size() && heap[entradas[m.indice].posicion] == m.indice;
+    }
 
 public:
-    // Agrega una tarea a la cola
-    void agregar(Tarea t) {
-        pq.push(t);
+    // "envejecimiento": cada cuantas tareas atendidas sube un nivel la
+    // prioridad de las que esperan (0 = nunca)
+    Gestor(int envejecimiento = 0) : envejecimiento(envejecimiento) {}
+
+    // Agrega una tarea a la cola y devuelve su manejador
+    ManejadorTarea agregar(Tarea t) {
+        uint32_t e;
+        if (!libres.empty()) {
+            e = libres.back();
+            libres.pop_back();
+        }
+        else {
+            e = entradas.size();
+            entradas.emplace_back();
+        }
+        Entrada& entrada = entradas[e];
+        entrada.llegada = atendidas;
+        entrada.orden = llegadas++;
+        entrada.clave = calcularClave(t.prioridad, entrada.llegada);
+        entrada.tarea = std::move(t);
+        heap.push_back(e);
+        subir(heap.size() - 1);
+        return ManejadorTarea{e, entrada.generacion};
+    }
+
+    // Cambia la prioridad de una tarea que sigue en la cola
+    bool cambiar_prioridad(ManejadorTarea m, int prioridad) {
+        if (!valido(m))
+            return false;
+        Entrada& entrada = entradas[m.indice];
+        entrada.tarea.prioridad = prioridad;
+        entrada.clave = calcularClave(prioridad, entrada.llegada);
+        subir(entrada.posicion);
+        bajar(entradas[m.indice].posicion);
+        return true;
+    }
+
+    // Quita de la cola una tarea que todavia no se atendio
+    bool cancelar(ManejadorTarea m) {
+        if (!valido(m))
+            return false;
+        quitar(m.indice);
+        return true;
     }
 
     // Devuelve cuántas tareas hay pendientes
     int size() {
-        return pq.size();
+        return heap.size();
     }
 
     // Atiende (procesa) la tarea con mayor prioridad
     void atender_tarea() {
-        if (!pq.empty()) {
-            Tarea t = pq.top();
+        if (!heap.empty()) {
+            Tarea t = std::move(entradas[heap[0]].tarea);
             cout << t << endl;  // muestra la tarea que se atiende
-            pq.pop();           // la elimina de la cola
+            quitar(heap[0]);    // la elimina de la cola
+            atendidas++;
+            if (t.trabajo)
+                t.trabajo();    // y la ejecuta si tiene trabajo asociado
+        }
+    }
+};
+
+// Reloj monotono en milisegundos. RelojManual permite controlar el tiempo
+// a mano (por ejemplo en pruebas) y RelojSistema usa el reloj real.
+class Reloj {
+public:
+    virtual uint64_t ahora() = 0;
+    virtual ~Reloj() {}
+};
+
+class RelojSistema : public Reloj {
+private:
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+public:
+    uint64_t ahora() override {
+        return chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - inicio).count();
+    }
+};
+
+class RelojManual : public Reloj {
+private:
+    uint64_t tiempo = 0;
+
+public:
+    uint64_t ahora() override {
+        return tiempo;
+    }
+
+    void avanzar(uint64_t ms) {
+        tiempo += ms;
+    }
+};
+
+// Identifica un temporizador para poder cancelarlo
+struct ManejadorTemporizador {
+    uint32_t indice = UINT32_MAX;
+    uint32_t generacion = 0;
+};
+
+// Rueda de temporizadores jerarquica: 4 niveles de 256 ranuras. El nivel 0
+// tiene una ranura por milisegundo, el nivel 1 una cada 256 ms, etc.
+// (alcanza ~49 dias; los mas lejanos se reubican al acercarse). Cada ranura
+// es una lista doblemente enlazada, asi programar y cancelar son O(1).
+// Al pasar el tiempo, las ranuras de niveles altos se "derraman" a los
+// niveles de abajo y la ranura del milisegundo actual se entrega entera.
+template<typename T = Tarea>
+class RuedaTemporizadores {
+private:
+    static constexpr int NIVELES = 4;
+    static constexpr int RANURAS = 256;
+    static constexpr uint32_t NINGUNO = UINT32_MAX;
+
+    struct Nodo {
+        T dato;
+        uint64_t vence;               // milisegundo en que vence
+        uint32_t anterior, siguiente; // enlaces de la lista de su ranura
+        uint32_t ranura;              // ranura donde esta (NINGUNO = libre)
+        uint32_t generacion = 0;
+    };
+
+    Reloj& reloj;
+    uint64_t actual;                              // ultimo milisegundo procesado
+    vector<Nodo> nodos;
+    vector<uint32_t> libres;
+    uint32_t cabezas[NIVELES * RANURAS];          // primer nodo de cada ranura
+    size_t cuantos[NIVELES] = {};                 // nodos en cada nivel
+    size_t pendientes = 0;
+
+    void enlazar(uint32_t n, uint32_t ranura) {
+        cuantos[ranura / RANURAS]++;
+        nodos[n].ranura = ranura;
+        nodos[n].anterior = NINGUNO;
+        nodos[n].siguiente = cabezas[ranura];
+        if (cabezas[ranura] != NINGUNO)
+            nodos[cabezas[ranura]].anterior = n;
+        cabezas[ranura] = n;
+    }
+
+    void desenlazar(uint32_t n) {
+        Nodo& nodo = nodos[n];
+        if (nodo.anterior != NINGUNO)
+            nodos[nodo.anterior].siguiente = nodo.siguiente;
+        else
+            cabezas[nodo.ranura] = nodo.siguiente;
+        if (nodo.siguiente != NINGUNO)
+            nodos[nodo.siguiente].anterior = nodo.anterior;
+        cuantos[nodo.ranura / RANURAS]--;
+        nodo.ranura = NINGUNO;
+    }
+
+    // Ubica el nodo segun cuanto falta para que venza
+    void ubicar(uint32_t n) {
+        uint64_t vence = nodos[n].vence;
+        uint64_t falta = vence - actual;
+        if (falta >= (1ULL << 32))
+            vence = actual + (1ULL << 32) - 1;    // muy lejos: se reubica despues
+        int nivel = falta < (1ULL << 8) ? 0 : falta < (1ULL << 16) ? 1 : falta < (1ULL << 24) ? 2 : 3;
+        enlazar(n, nivel * RANURAS + ((vence >> (8 * nivel)) & (RANURAS - 1)));
+    }
+
+    void liberar(uint32_t n) {
+        nodos[n].dato = T();
+        nodos[n].generacion++;
+        libres.push_back(n);
+        pendientes--;
+    }
+
+public:
+    RuedaTemporizadores(Reloj& reloj) : reloj(reloj), actual(reloj.ahora()) {
+        fill(begin(cabezas), end(cabezas), NINGUNO);
+    }
+
+    // Programa "dato" para dentro de "retraso" ms (al menos 1 ms)
+    ManejadorTemporizador programar(T dato, uint64_t retraso) {
+        uint32_t n;
+        if (!libres.empty()) {
+            n = libres.back();
+            libres.pop_back();
+        }
+        else {
+            n = nodos.size();
+            nodos.emplace_back();
+        }
+        // Contamos desde ahora (aunque la rueda aun no haya avanzado hasta aqui)
+        uint64_t base = max(actual, reloj.ahora());
+        nodos[n].dato = std::move(dato);
+        nodos[n].vence = base + max(retraso, (uint64_t)1);
+        ubicar(n);
+        pendientes++;
+        return ManejadorTemporizador{n, nodos[n].generacion};
+    }
+
+    // Cancela un temporizador que aun no vencio
+    bool cancelar(ManejadorTemporizador m) {
+        if (m.indice >= nodos.size() || nodos[m.indice].generacion != m.generacion ||
+            nodos[m.indice].ranura == NINGUNO)
+            return false;
+        desenlazar(m.indice);
+        liberar(m.indice);
+        return true;
+    }
+
+    // Avanza hasta el tiempo del reloj y entrega con "entregar(T&&)" todo
+    // lo que vencio, en orden de vencimiento. Devuelve cuantos entrego.
+    template<typename F>
+    size_t avanzar(F&& entregar) {
+        uint64_t hasta = reloj.ahora();
+        size_t entregados = 0;
+        while (actual < hasta) {
+            // Si los niveles de abajo estan vacios no puede vencer nada antes
+            // del proximo derrame: saltamos directo hasta ahi
+            uint64_t siguiente = actual + 1;
+            for (int nivel = 0; nivel < NIVELES - 1 && cuantos[nivel] == 0; nivel++)
+                siguiente = (actual | ((1ULL << (8 * (nivel + 1))) - 1)) + 1;
+            if (pendientes == 0 || siguiente > hasta) {
+                actual = hasta;
+                break;
+            }
+            actual = siguiente;
+            // Derramamos las ranuras de los niveles altos que empiezan ahora:
+            // el nivel k+1 cuando el indice del nivel k vuelve a 0. Vamos de
+            // arriba hacia abajo para que lo derramado pueda volver a bajar.
+            int niveles = 0;
+            while (niveles < NIVELES - 1 && ((actual >> (8 * niveles)) & (RANURAS - 1)) == 0)
+                niveles++;
+            for (int nivel = niveles; nivel >= 1; nivel--) {
+                uint32_t ranura = nivel * RANURAS + ((actual >> (8 * nivel)) & (RANURAS - 1));
+                uint32_t n = cabezas[ranura];
+                cabezas[ranura] = NINGUNO;
+                while (n != NINGUNO) {
+                    uint32_t proximo = nodos[n].siguiente;
+                    cuantos[nivel]--;
+                    ubicar(n);
+                    n = proximo;
+                }
+            }
+            // Entregamos la ranura del milisegundo actual completa
+            uint32_t ranura = actual & (RANURAS - 1);
+            uint32_t n = cabezas[ranura];
+            cabezas[ranura] = NINGUNO;
+            while (n != NINGUNO) {
+                uint32_t proximo = nodos[n].siguiente;
+                cuantos[0]--;
+                nodos[n].ranura = NINGUNO;
+                entregar(std::move(nodos[n].dato));
+                liberar(n);
+                entregados++;
+                n = proximo;
+            }
+        }
+        return entregados;
+    }
+
+    // Pasa al Gestor las tareas que ya vencieron
+    size_t avanzar(Gestor& gestor) requires same_as<T, Tarea> {
+        return avanzar([&gestor](Tarea&& t) { gestor.agregar(std::move(t)); });
+    }
+
+    size_t size() const {
+        return pendientes;
+    }
+};
+
+// Cola de temporizadores con un heap (para comparar con la rueda). Cancelar
+// solo marca el temporizador; se descarta cuando llega arriba del heap.
+template<typename T>
+class HeapTemporizadores {
+private:
+    Reloj& reloj;
+    // (vencimiento, indice): el que vence primero arriba
+    priority_queue<pair<uint64_t, uint32_t>, vector<pair<uint64_t, uint32_t>>,
+                   greater<pair<uint64_t, uint32_t>>> heap;
+    vector<T> datos;
+    vector<bool> cancelados;
+
+public:
+    HeapTemporizadores(Reloj& reloj) : reloj(reloj) {}
+
+    uint32_t programar(T dato, uint64_t retraso) {
+        uint32_t n = datos.size();
+        datos.push_back(std::move(dato));
+        cancelados.push_back(false);
+        heap.push(make_pair(reloj.ahora() + max(retraso, (uint64_t)1), n));
+        return n;
+    }
+
+    void cancelar(uint32_t n) {
+        cancelados[n] = true;
+    }
+
+    template<typename F>
+    size_t avanzar(F&& entregar) {
+        uint64_t hasta = reloj.ahora();
+        size_t entregados = 0;
+        while (!heap.empty() && heap.top().first <= hasta) {
+            uint32_t n = heap.top().second;
+            heap.pop();
+            if (!cancelados[n]) {
+                entregar(std::move(datos[n]));
+                entregados++;
+            }
+        }
+        return entregados;
+    }
+};
+
+// Programa n temporizadores (retrasos de hasta 10 minutos), cancela 1 de
+// cada 10 y avanza el reloj hasta que vencen todos, con la rueda y con el heap
+void compararTemporizadores(int n) {
+    mt19937 gen(11);
+    uniform_int_distribution<uint64_t> retraso(1, 600000);
+    vector<uint64_t> retrasos(n);
+    for (uint64_t& r : retrasos)
+        r = retraso(gen);
+
+    auto medir = [&](auto& cola, RelojManual& reloj, auto cancelar, const char* nombre) {
+        auto t0 = chrono::steady_clock::now();
+        vector<decltype(cola.programar(0, 1))> manejadores;
+        manejadores.reserve(n);
+        for (int i = 0; i < n; i++)
+            manejadores.push_back(cola.programar(i, retrasos[i]));
+        auto t1 = chrono::steady_clock::now();
+        for (int i = 0; i < n; i += 10)
+            cancelar(cola, manejadores[i]);
+        auto t2 = chrono::steady_clock::now();
+        size_t entregados = 0;
+        for (int paso = 0; paso < 600; paso++) {        // de a 1 segundo
+            reloj.avanzar(1000);
+            entregados += cola.avanzar([](uint32_t) {});
+        }
+        auto t3 = chrono::steady_clock::now();
+        cout << nombre << ": programar " << chrono::duration<double, milli>(t1 - t0).count()
+             << " ms, cancelar " << chrono::duration<double, milli>(t2 - t1).count()
+             << " ms, vencer " << chrono::duration<double, milli>(t3 - t2).count()
+             << " ms (" << entregados << " entregados)" << endl;
+    };
+
+    {
+        RelojManual reloj;
+        RuedaTemporizadores<uint32_t> rueda(reloj);
+        medir(rueda, reloj, [](auto& c, ManejadorTemporizador m) { c.cancelar(m); }, "Rueda");
+    }
+    {
+        RelojManual reloj;
+        HeapTemporizadores<uint32_t> heap(reloj);
+        medir(heap, reloj, [](auto& c, uint32_t m) { c.cancelar(m); }, "Heap ");
+    }
+}
+
+// Planificador de tareas para todos los nucleos, construido sobre la idea
+// del Gestor: cada trabajador (hilo) tiene sus propias colas, una por banda
+// de prioridad (banda 0 = prioridad mas alta). Un trabajador libre busca
+// primero en la banda mas alta, en su cola y robando de las de los demas,
+// y solo baja de banda si no encuentra nada: una tarea urgente recien
+// llegada pasa delante de todas las tareas menos urgentes que esperan.
+class Planificador {
+public:
+    static const int BANDAS = 4;            // prioridades 0..3 (3 es la mas alta)
+    static const int CUBETAS = 32;          // histograma de latencias (potencias de 2 en us)
+
+    // Estadisticas de un trabajador
+    struct Estadisticas {
+        size_t profundidad;                 // tareas en sus colas ahora
+        uint64_t ejecutadas;                // tareas que ejecuto
+        uint64_t robadas;                   // tareas que robo a otros trabajadores
+        uint64_t latencias[CUBETAS];        // cubeta k: espera en [2^(k-1), 2^k) us
+    };
+
+private:
+    struct TareaPendiente {
+        Tarea tarea;
+        chrono::steady_clock::time_point llegada;
+    };
+
+    struct Trabajador {
+        mutex candado;                                // protege las colas
+        deque<TareaPendiente> colas[BANDAS];
+        atomic<uint64_t> ejecutadas{0};
+        atomic<uint64_t> robadas{0};
+        atomic<uint64_t> latencias[CUBETAS] = {};
+    };
+
+    vector<unique_ptr<Trabajador>> trabajadores;
+    vector<thread> hilos;
+    atomic<size_t> siguiente{0};          // reparto round-robin de tareas externas
+    atomic<long long> pendientes{0};      // tareas agregadas y no terminadas
+    atomic<long long> enCola{0};          // tareas en alguna cola (nadie las tomo)
+    mutex candadoEspera;
+    condition_variable hayTrabajo;        // despierta trabajadores dormidos
+    condition_variable terminaron;        // avisa a esperar() que no queda nada
+    bool detener = false;
+
+    // Planificador e indice del trabajador del hilo actual ({nullptr, -1}
+    // si no es un trabajador). Se guarda el planificador porque una tarea
+    // puede agregar tareas a otro planificador distinto del suyo.
+    static pair<Planificador*, int>& trabajadorActual() {
+        thread_local pair<Planificador*, int> actual(nullptr, -1);
+        return actual;
+    }
+
+    // Banda de una prioridad: la mayor prioridad va a la banda 0
+    static int banda(int prioridad) {
+        return BANDAS - 1 - clamp(prioridad, 0, BANDAS - 1);
+    }
+
+    // Saca una tarea de la banda dada del trabajador "w"; el dueño toma la
+    // mas antigua y los ladrones la mas nueva (se pisan menos)
+    bool sacar(int w, int b, bool robo, TareaPendiente& tarea) {
+        Trabajador& t = *trabajadores[w];
+        lock_guard<mutex> lock(t.candado);
+        deque<TareaPendiente>& cola = t.colas[b];
+        if (cola.empty())
+            return false;
+        if (robo) {
+            tarea = std::move(cola.back());
+            cola.pop_back();
+        }
+        else {
+            tarea = std::move(cola.front());
+            cola.pop_front();
+        }
+        return true;
+    }
+
+    // Busca la tarea mas urgente: banda por banda, primero la propia cola
+    // y despues las de los demas empezando por el vecino
+    bool buscarTarea(int yo, TareaPendiente& tarea) {
+        int n = trabajadores.size();
+        for (int b = 0; b < BANDAS; b++) {
+            if (sacar(yo, b, false, tarea))
+                return true;
+            for (int k = 1; k < n; k++) {
+                if (sacar((yo + k) % n, b, true, tarea)) {
+                    trabajadores[yo]->robadas++;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void ejecutar(int yo, TareaPendiente& pendiente) {
+        Trabajador& t = *trabajadores[yo];
+        uint64_t espera = chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - pendiente.llegada).count();
+        int cubeta = min(CUBETAS - 1, (int)bit_width(espera));
+        t.latencias[cubeta]++;
+        if (pendiente.tarea.trabajo)
+            pendiente.tarea.trabajo();
+        t.ejecutadas++;
+        if (--pendientes == 0) {
+            lock_guard<mutex> lock(candadoEspera);
+            terminaron.notify_all();
+            if (detener)
+                hayTrabajo.notify_all();    // los dormidos ya pueden salir
+        }
+    }
+
+    void bucle(int yo) {
+        trabajadorActual() = {this, yo};
+        TareaPendiente tarea;
+        while (true) {
+            if (buscarTarea(yo, tarea)) {
+                enCola--;
+                ejecutar(yo, tarea);
+                continue;
+            }
+            // Sin trabajo: dormimos hasta que llegue algo o haya que detenerse.
+            // agregar() suma a enCola con candadoEspera tomado antes de
+            // avisar, asi que el aviso no se pierde entre la busqueda y wait
+            unique_lock<mutex> lock(candadoEspera);
+            hayTrabajo.wait(lock, [this]() { return enCola > 0 || (detener && pendientes == 0); });
+            if (enCola <= 0)
+                return;
+        }
+    }
+
+public:
+    // Crea "cantidad" trabajadores (por defecto uno por nucleo)
+    Planificador(int cantidad = thread::hardware_concurrency()) {
+        cantidad = max(cantidad, 1);
+        for (int i = 0; i < cantidad; i++)
+            trabajadores.push_back(make_unique<Trabajador>());
+        for (int i = 0; i < cantidad; i++)
+            hilos.emplace_back(&Planificador::bucle, this, i);
+    }
+
+    // Termina las tareas pendientes y detiene a los trabajadores
+    ~Planificador() {
+        {
+            lock_guard<mutex> lock(candadoEspera);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (thread& h : hilos)
+            h.join();
+    }
+
+    // Agrega una tarea. Desde un trabajador va a su propia cola; desde
+    // afuera se reparte entre los trabajadores.
+    void agregar(Tarea t) {
+        auto [duenio, w] = trabajadorActual();
+        if (duenio != this)
+            w = siguiente++ % trabajadores.size();
+        pendientes++;
+        {
+            Trabajador& destino = *trabajadores[w];
+            lock_guard<mutex> lock(destino.candado);
+            destino.colas[banda(t.prioridad)].push_back(
+                TareaPendiente{std::move(t), chrono::steady_clock::now()});
+        }
+        {
+            lock_guard<mutex> lock(candadoEspera);
+            enCola++;
+        }
+        hayTrabajo.notify_one();
+    }
+
+    // Espera a que no queden tareas pendientes
+    void esperar() {
+        unique_lock<mutex> lock(candadoEspera);
+        terminaron.wait(lock, [this]() { return pendientes == 0; });
+    }
+
+    // Devuelve las estadisticas de cada trabajador
+    vector<Estadisticas> estadisticas() {
+        vector<Estadisticas> resultado;
+        for (auto& t : trabajadores) {
+            Estadisticas e;
+            {
+                lock_guard<mutex> lock(t->candado);
+                e.profundidad = 0;
+                for (int b = 0; b < BANDAS; b++)
+                    e.profundidad += t->colas[b].size();
+            }
+            e.ejecutadas = t->ejecutadas;
+            e.robadas = t->robadas;
+            for (int k = 0; k < CUBETAS; k++)
+                e.latencias[k] = t->latencias[k];
+            resultado.push_back(e);
+        }
+        return resultado;
+    }
+
+    // Muestra las estadisticas de cada trabajador
+    void mostrarEstadisticas() {
+        vector<Estadisticas> todas = estadisticas();
+        for (size_t i = 0; i < todas.size(); i++) {
+            Estadisticas& e = todas[i];
+            cout << "Trabajador " << i << ": en cola " << e.profundidad
+                 << ", ejecutadas " << e.ejecutadas << ", robadas " << e.robadas
+                 << ", latencias (us):";
+            for (int k = 0; k < CUBETAS; k++) {
+                if (e.latencias[k] != 0)
+                    cout << " <" << (1ULL << k) << ":" << e.latencias[k];
+            }
+            cout << endl;
         }
     }
 };
@@ -120,6 +1253,52 @@ int main() {
         gestor.atender_tarea();
     }
 
+    /*
+    // Ejemplo de cambiar prioridad, cancelar y envejecimiento
+    Gestor gestor2(2);                    // cada 2 atendidas, las demas suben 1
+    ManejadorTarea d = gestor2.agregar(Tarea("D", 1));
+    ManejadorTarea e = gestor2.agregar(Tarea("E", 1));
+    gestor2.cambiar_prioridad(d, 5);      // D pasa adelante
+    gestor2.cancelar(e);                  // E ya no se atiende
+    gestor2.agregar(Tarea("L", 1));       // tarea de baja prioridad
+    for (int i = 0; i < 6; i++) {         // siguen llegando tareas de prioridad 2
+        gestor2.agregar(Tarea("F" + to_string(i), 2));
+        gestor2.atender_tarea();          // D, F0, F1, L, ... (sin envejecimiento L saldria al final)
+    }
+    */
+
+    /*
+    // Ejemplo de tareas programadas: la rueda las pasa al Gestor al vencer
+    RelojManual reloj;
+    RuedaTemporizadores<Tarea> rueda(reloj);
+    Gestor gestor3;
+    rueda.programar(Tarea("Reintento", 1), 500);
+    ManejadorTemporizador m = rueda.programar(Tarea("Recordatorio", 2), 1000);
+    rueda.programar(Tarea("Reporte", 3), 2000);
+    rueda.cancelar(m);
+    reloj.avanzar(2000);
+    rueda.avanzar(gestor3);               // pasan Reintento y Reporte
+    while (gestor3.size() != 0)
+        gestor3.atender_tarea();
+    compararTemporizadores(10000000);
+    */
+
+    /*
+    // Ejemplo del Planificador: muchas tareas en todos los nucleos
+    Planificador planificador;
+    atomic<long long> suma{0};
+    for (int i = 0; i < 100000; i++) {
+        planificador.agregar(Tarea("T" + to_string(i), i % 4, [&suma, i]() {
+            long long x = 0;
+            for (int k = 0; k < 1000; k++)
+                x += (i * k) % 7;
+            suma += x;
+        }));
+    }
+    planificador.esperar();
+    planificador.mostrarEstadisticas();
+    */
+
     /*
     // Ejercicio con priority_queue<int>
     priority_queue<int> pq;
@@ -138,6 +1317,14 @@ int main() {
     colaImpresion.push(Documento("slide_10.ppt",   "04/06/2025"));
     // ... (muestra y procesa la cola de impresión)
 
+    // Cola de impresion en paralelo: escribe los lotes en "impresora/"
+    ColaImpresion spooler("impresora", 4, 1024);
+    for (int i = 0; i < 100000; i++)
+        spooler.imprimir(Documento("doc_" + to_string(i) + ".txt", "05/06/2025"));
+    spooler.terminar();
+    spooler.mostrarEstadisticas();
+    filesystem::remove_all("impresora");
+
     // Ejercicio con Banco y tickets
     this_thread::sleep_for(chrono::seconds(1)); // pausa 1 segundo
     Banco banco;
@@ -149,6 +1336,15 @@ int main() {
     banco.atenderCliente();
     banco.mostrarClientesEnEspera();
     // ...
+
+    // Listado paginado: solo las posiciones 1000 a 1050
+    for (int i = 0; i < 100000; i++)
+        banco.sacarticket("Cliente" + to_string(i));
+    banco.mostrarClientesEnEspera(1000, 1050);
+
+    // Ejercicio con varios kioscos y cajeros a la vez
+    for (int hilos = 1; hilos <= 8; hilos *= 2)
+        simularBanco(hilos, hilos, 200000);
     */
 
     return 0;
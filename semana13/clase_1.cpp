@@ -1,6 +1,21 @@
 // ARBOL BINARIO DE BUSQUEDA
 
 #include <iostream>
+#include <climits>    // para INT_MAX
+#include <vector>
+#include <bit>        // para countr_one (busqueda Eytzinger)
+#include <chrono>     // para medir tiempos en la comparacion
+#include <random>     // para generar consultas aleatorias
+#include <stdexcept>  // para invalid_argument y runtime_error
+#include <algorithm>  // para shuffle
+#include <atomic>     // para el BST concurrente
+#include <mutex>
+#include <thread>
+#include <string>
+#include <string_view>
+#include <memory>     // para unique_ptr (valores solo movibles)
+#include <cstring>    // para memset y memcpy
+#include <functional> // para less
 using namespace std;
 
 // Estructura que representa un nodo en el Arbol
@@ -8,35 +23,47 @@ struct Nodo {
     int dato;        // valor almacenado en el nodo
     Nodo* left;      // puntero al hijo izquierdo
     Nodo* right;     // puntero al hijo derecho
+    Nodo* padre;     // puntero al padre (NULL en la raiz)
+    int tam;         // cantidad de nodos del subarbol que empieza aqui
 
-    // Constructor: inicializa el dato y establece hijos en NULL
-    Nodo(int dato) {
+    // Constructor: inicializa el dato, enlaza al padre y establece hijos en NULL
+    Nodo(int dato, Nodo* padre = NULL) {
         this->dato = dato;
         this->left = NULL;
         this->right = NULL;
+        this->padre = padre;
+        this->tam = 1;
     }
 };
 
+// Devuelve el tamaño del subarbol de "nodo" (0 si esta vacio)
+int tam(Nodo* nodo) {
+    return nodo == NULL ? 0 : nodo->tam;
+}
+
 // Clase que implementa un Binary Search Tree (sin valores repetidos)
 class BST {
 private:
     Nodo* raiz = NULL;  // puntero a la raíz del árbol, inicialmente vacío
 
     // Inserta recursivamente un nodo con valor x en el subárbol de "nodo"
-    Nodo* insertarNodoAux(Nodo* nodo, int x) {
+    // "padre" es el nodo desde el que llegamos (para enlazar al nuevo nodo)
+    Nodo* insertarNodoAux(Nodo* nodo, int x, Nodo* padre) {
         if (nodo == NULL) {
-            // Si el lugar está libre creamos un nuevo nodo
-            return new Nodo(x);
+            // Si el lugar está libre creamos un nuevo nodo enlazado a su padre
+            return new Nodo(x, padre);
         }
         if (x < nodo->dato) {
             // Si x es menor vamos al subarbol izquierdo
-            nodo->left = insertarNodoAux(nodo->left, x);
+            nodo->left = insertarNodoAux(nodo->left, x, nodo);
         }
         else if (x > nodo->dato) {
             // Si x es mayor vamos al subarbol derecho
-            nodo->right = insertarNodoAux(nodo->right, x);
+            nodo->right = insertarNodoAux(nodo->right, x, nodo);
         }
         // Si x es igual no insertamos duplicados
+        // Actualizamos el tamaño del subarbol al volver de la recursion
+        nodo->tam = 1 + tam(nodo->left) + tam(nodo->right);
         return nodo;
     }
 
@@ -54,15 +81,6 @@ private:
             return buscarAux(nodo->right, x);
     }
 
-    // Recorre el arbol en orden (izquierda, nodo, derecha)
-    void imprimirEnOrderAux(Nodo* nodo) {
-        if (nodo == NULL)
-            return;
-        imprimirEnOrderAux(nodo->left);
-        cout << nodo->dato << ' ';
-        imprimirEnOrderAux(nodo->right);
-    }
-
     // Recorre el arbol en preorden (nodo, izquierda, derecha)
     void imprimirPreOrderAux(Nodo* nodo) {
         if (nodo == NULL)
@@ -90,109 +108,217 @@ private:
         delete nodo;
     }
 
+    // Devuelve el nodo mas a la izquierda del subarbol de "nodo"
+    static Nodo* minimoNodo(Nodo* nodo) {
+        while (nodo->left != NULL)
+            nodo = nodo->left;       // el mas izquierdo es el menor
+        return nodo;
+    }
+
+    // Devuelve el nodo mas a la derecha del subarbol de "nodo"
+    static Nodo* maximoNodo(Nodo* nodo) {
+        while (nodo->right != NULL)
+            nodo = nodo->right;      // el más derecho es el mayor
+        return nodo;
+    }
+
     // Devuelve el valor minimo del subarbol de "nodo"
     int minimoAux(Nodo* nodo) {
-        if (nodo->left == NULL)
-            return nodo->dato;       // el mas izquierdo es el menor
-        return minimoAux(nodo->left);
+        return minimoNodo(nodo)->dato;
     }
 
     // Devuelve el valor máximo del subárbol de "nodo"
     int maximoAux(Nodo* nodo) {
-        if (nodo->right == NULL)
-            return nodo->dato;       // el más derecho es el mayor
-        return maximoAux(nodo->right);
+        return maximoNodo(nodo)->dato;
     }
 
-    // Encuentra el sucesor en orden del nodo dado
-    Nodo* sucesorAux(Nodo* nodo) {
+    // Encuentra el sucesor en orden del nodo dado (sin volver a la raiz)
+    static Nodo* sucesorAux(Nodo* nodo) {
         // Caso 1: tiene subarbol derecho → mínimo de ese subarbol
         if (nodo->right != NULL)
-            return this->buscar(minimoAux(nodo->right));
-        // Caso 2: sin hijo derecho → buscamos ancestro que lo contenga a la izquierda
-        Nodo* ancestro = raiz;
-        Nodo* sucesor = NULL;
-        while (ancestro != nodo) {
-            if (nodo->dato < ancestro->dato) {
-                sucesor = ancestro;
-                ancestro = ancestro->left;
+            return minimoNodo(nodo->right);
+        // Caso 2: sin hijo derecho → subimos mientras seamos hijo derecho;
+        // el primer ancestro al que llegamos por la izquierda es el sucesor
+        Nodo* padre = nodo->padre;
+        while (padre != NULL && nodo == padre->right) {
+            nodo = padre;
+            padre = padre->padre;
+        }
+        return padre;
+    }
+
+    // Encuentra el predecesor en orden del nodo dado (simetrico al sucesor)
+    static Nodo* predecesorAux(Nodo* nodo) {
+        // Caso 1: tiene subarbol izquierdo → máximo de ese subarbol
+        if (nodo->left != NULL)
+            return maximoNodo(nodo->left);
+        // Caso 2: subimos mientras seamos hijo izquierdo
+        Nodo* padre = nodo->padre;
+        while (padre != NULL && nodo == padre->left) {
+            nodo = padre;
+            padre = padre->padre;
+        }
+        return padre;
+    }
+
+    // Pone "hijo" en el lugar de "nodo" dentro de su padre (o de la raiz)
+    void reemplazarEnPadre(Nodo* nodo, Nodo* hijo) {
+        if (hijo != NULL)
+            hijo->padre = nodo->padre;
+        if (nodo->padre == NULL)
+            raiz = hijo;                    // "nodo" era la raiz
+        else if (nodo->padre->left == nodo)
+            nodo->padre->left = hijo;
+        else
+            nodo->padre->right = hijo;
+    }
+
+    // Elimina el nodo dado (aplica tres casos: hoja, un hijo, dos hijos)
+    void eliminarAux(Nodo* nodo) {
+        // Caso 3: dos hijos → copiamos el valor del sucesor y eliminamos
+        // ese sucesor, que como es el minimo del subarbol derecho no tiene
+        // hijo izquierdo (cae en el caso 1 o 2)
+        if (nodo->left != NULL && nodo->right != NULL) {
+            Nodo* suc = minimoNodo(nodo->right);
+            nodo->dato = suc->dato;
+            nodo = suc;
+        }
+        // Caso 1 y 2: hoja o un solo hijo → el padre apunta al hijo (o a NULL)
+        if (nodo->left != NULL)
+            reemplazarEnPadre(nodo, nodo->left);
+        else
+            reemplazarEnPadre(nodo, nodo->right);
+        // Todos los ancestros pierden un nodo en su subarbol
+        for (Nodo* p = nodo->padre; p != NULL; p = p->padre)
+            p->tam--;
+        delete nodo;
+    }
+
+    // Construye un subarbol perfectamente balanceado con valores[ini, fin)
+    // tomando como raiz el elemento del medio (cada valor se visita una vez)
+    Nodo* construirBalanceado(const vector<int>& valores, int ini, int fin, Nodo* padre) {
+        if (ini >= fin)
+            return NULL;
+        int medio = ini + (fin - ini) / 2;
+        Nodo* nodo = new Nodo(valores[medio], padre);
+        nodo->left = construirBalanceado(valores, ini, medio, nodo);
+        nodo->right = construirBalanceado(valores, medio + 1, fin, nodo);
+        nodo->tam = fin - ini;
+        return nodo;
+    }
+
+    // Devuelve el primer nodo con valor >= x (NULL si no hay)
+    Nodo* primeroMayorOIgual(int x) {
+        Nodo* nodo = raiz;
+        Nodo* candidato = NULL;
+        while (nodo != NULL) {
+            if (nodo->dato >= x) {
+                candidato = nodo;       // sirve, buscamos uno menor a la izquierda
+                nodo = nodo->left;
+            }
+            else {
+                nodo = nodo->right;
+            }
+        }
+        return candidato;
+    }
+
+    // Cuenta los valores menores que x (o menores o iguales si "incluir")
+    int contarMenores(int x, bool incluir) {
+        int cuenta = 0;
+        Nodo* nodo = raiz;
+        while (nodo != NULL) {
+            if (nodo->dato < x || (incluir && nodo->dato == x)) {
+                // El nodo y todo su subarbol izquierdo cuentan
+                cuenta += tam(nodo->left) + 1;
+                nodo = nodo->right;
             }
             else {
-                ancestro = ancestro->right;
+                nodo = nodo->left;
             }
         }
-        return sucesor;
+        return cuenta;
     }
 
-    // Devuelve el padre del nodo con valor x en el subárbol de "nodo"
-    Nodo* padreAux(Nodo* nodo, int x) {
-        if (nodo == NULL || nodo->dato == x)
-            return NULL;  // la raíz o nodo inexistente no tienen padre
+public:
+    // Iterador bidireccional en orden: guarda el nodo actual y avanza
+    // con sucesor/predecesor usando los punteros al padre (sin recursion)
+    class Iterador {
+    private:
+        Nodo* actual;       // nodo actual (NULL = fin del recorrido)
+        const BST* arbol;   // arbol recorrido (para retroceder desde el fin)
 
-        // Comprobamos si alguno de los hijos es "x"
-        if (nodo->left != NULL && nodo->left->dato == x)
-            return nodo;
-        if (nodo->right != NULL && nodo->right->dato == x)
-            return nodo;
+    public:
+        Iterador(Nodo* actual, const BST* arbol)
+            : actual(actual), arbol(arbol) {}
 
-        // Recorremos según comparación
-        if (x < nodo->dato)
-            return padreAux(nodo->left, x);
-        else
-            return padreAux(nodo->right, x);
-    }
+        // Devuelve el valor del nodo actual
+        int operator*() const {
+            return actual->dato;
+        }
 
-    // Elimina el nodo dado (aplica tres casos: hoja, un hijo, dos hijos)
-    void eliminarAux(Nodo* nodo, int x) {
-        // Caso 1: hoja (sin hijos)
-        if (nodo->left == NULL && nodo->right == NULL) {
-            Nodo* padre_x = this->padreAux(raiz, x);
-            if (padre_x != NULL) {
-                // Desconectamos el puntero del padre
-                if (padre_x->left != NULL && padre_x->left->dato == x)
-                    padre_x->left = NULL;
-                else
-                    padre_x->right = NULL;
+        // Avanza al sucesor en orden
+        Iterador& operator++() {
+            actual = sucesorAux(actual);
+            return *this;
+        }
+
+        // Retrocede al predecesor en orden (desde el fin va al maximo)
+        Iterador& operator--() {
+            if (actual == NULL) {
+                // --end() de un arbol vacio sigue siendo end()
+                if (arbol->raiz != NULL)
+                    actual = maximoNodo(arbol->raiz);
             }
-            delete nodo;
-        }
-        // Caso 2: un solo hijo izquierdo
-        else if (nodo->left != NULL && nodo->right == NULL) {
-            Nodo* padre_x = this->padreAux(raiz, x);
-            // Reemplazamos el enlace del padre al único hijo
-            if (padre_x->left != NULL && padre_x->left->dato == x)
-                padre_x->left = nodo->left;
             else
-                padre_x->right = nodo->left;
-            delete nodo;
-        }
-        // Caso 2b: un solo hijo derecho
-        else if (nodo->left == NULL && nodo->right != NULL) {
-            Nodo* padre_x = this->padreAux(raiz, x);
-            if (padre_x->left != NULL && padre_x->left->dato == x)
-                padre_x->left = nodo->right;
-            else
-                padre_x->right = nodo->right;
-            delete nodo;
+                actual = predecesorAux(actual);
+            return *this;
         }
-        // Caso 3: dos hijos → sustituir por sucesor
-        else {
-            Nodo* suc = this->sucesorAux(nodo);
-            int tmp = suc->dato;
-            this->eliminarAux(suc, tmp);  // eliminamos sucesor
-            nodo->dato = tmp;             // copiamos su valor aquí
+
+        bool operator==(const Iterador& otro) const {
+            return actual == otro.actual;
+        }
+
+        bool operator!=(const Iterador& otro) const {
+            return actual != otro.actual;
         }
+    };
+
+    // Rango perezoso [desde, hasta): no copia valores, solo los recorre
+    // con el iterador a medida que se piden
+    class Rango {
+    private:
+        Iterador desde, hasta;
+
+    public:
+        Rango(Iterador desde, Iterador hasta)
+            : desde(desde), hasta(hasta) {}
+
+        Iterador begin() const { return desde; }
+        Iterador end() const { return hasta; }
+    };
+
+    // Iterador al menor valor del arbol
+    Iterador begin() const {
+        if (raiz == NULL)
+            return end();
+        return Iterador(minimoNodo(raiz), this);
+    }
+
+    // Iterador al fin del recorrido (uno despues del mayor)
+    Iterador end() const {
+        return Iterador(NULL, this);
     }
 
-public:
     // Inserta un valor x en el arbol
     void insertarNodo(int x) {
-        raiz = insertarNodoAux(raiz, x);
+        raiz = insertarNodoAux(raiz, x, NULL);
     }
 
-    // Imprime todos los valores en orden ascendente
+    // Imprime todos los valores en orden ascendente (usando el iterador)
     void imprimirEnOrder() {
-        imprimirEnOrderAux(raiz);
+        for (int x : *this)
+            cout << x << ' ';
         cout << endl;
     }
 
@@ -213,6 +339,17 @@ public:
         eliminar(raiz);
     }
 
+    // Reemplaza el contenido del arbol por "valores" (ordenados y sin
+    // repetidos) construyendo un arbol balanceado en O(n)
+    void cargarOrdenado(const vector<int>& valores) {
+        for (int i = 1; i < (int)valores.size(); i++) {
+            if (valores[i - 1] >= valores[i])
+                throw invalid_argument("cargarOrdenado: valores no ordenados o repetidos");
+        }
+        eliminar(raiz);
+        raiz = construirBalanceado(valores, 0, valores.size(), NULL);
+    }
+
     // Busca y devuelve el puntero al nodo con valor x
     Nodo* buscar(int x) {
         return buscarAux(raiz, x);
@@ -236,11 +373,67 @@ public:
         return sucesorAux(nodo_x);
     }
 
+    // Devuelve el puntero al predecesor de x
+    Nodo* predecesor(int x) {
+        Nodo* nodo_x = buscarAux(raiz, x);
+        if (nodo_x == NULL)
+            return NULL;
+        return predecesorAux(nodo_x);
+    }
+
+    // Devuelve el rango perezoso de valores en [a, b]
+    Rango rango(int a, int b) {
+        if (a > b)
+            return Rango(end(), end());
+        Nodo* desde = primeroMayorOIgual(a);
+        // El rango termina en el primer valor > b
+        Nodo* hasta = b == INT_MAX ? NULL : primeroMayorOIgual(b + 1);
+        if (desde == hasta)
+            return Rango(end(), end());
+        return Rango(Iterador(desde, this), Iterador(hasta, this));
+    }
+
+    // Devuelve el nodo con el k-esimo menor valor (k empieza en 1)
+    Nodo* k_esimo(int k) {
+        Nodo* nodo = raiz;
+        while (nodo != NULL) {
+            int izquierda = tam(nodo->left);
+            if (k <= izquierda) {
+                nodo = nodo->left;          // esta en el subarbol izquierdo
+            }
+            else if (k == izquierda + 1) {
+                return nodo;                // es este nodo
+            }
+            else {
+                k -= izquierda + 1;         // saltamos izquierda y nodo
+                nodo = nodo->right;
+            }
+        }
+        return NULL;                        // k fuera de rango
+    }
+
+    // Devuelve cuantos valores del arbol son menores que x
+    int rank(int x) {
+        return contarMenores(x, false);
+    }
+
+    // Devuelve cuantos valores hay en [a, b]
+    int contar_en_rango(int a, int b) {
+        if (a > b)
+            return 0;
+        return contarMenores(b, true) - contarMenores(a, false);
+    }
+
+    // Devuelve la cantidad de valores en el arbol
+    int size() {
+        return tam(raiz);
+    }
+
     // Elimina el nodo con valor x si existe
     void eliminar(int x) {
         Nodo* nodo = buscar(x);
         if (nodo != NULL)
-            eliminarAux(nodo, x);
+            eliminarAux(nodo);
     }
 
     // Devuelve el padre del nodo con valor x
@@ -248,10 +441,666 @@ public:
         Nodo* nodo = buscar(x);
         if (nodo == NULL)
             return NULL;
-        return padreAux(raiz, x);
+        return nodo->padre;
+    }
+};
+
+// Copia de solo lectura de un BST guardada en un arreglo en orden
+// Eytzinger (por niveles, como un heap): los hijos de k estan en 2k y 2k+1,
+// asi los primeros niveles comparten pocas lineas de cache y la busqueda
+// no necesita punteros ni saltos condicionales
+class BSTEstatico {
+private:
+    vector<int> datos;   // datos[1..n] en orden por niveles (datos[0] no se usa)
+    int n;               // cantidad de valores
+
+    // Recorre el arbol implicito en orden y le asigna los valores ordenados
+    void construir(const vector<int>& ordenados, int& i, int k) {
+        if (k > n)
+            return;
+        construir(ordenados, i, 2 * k);
+        datos[k] = ordenados[i++];
+        construir(ordenados, i, 2 * k + 1);
+    }
+
+    // Devuelve la posicion del primer valor > x (o >= x si "incluir"),
+    // 0 si no existe
+    int buscarPosicion(int x, bool incluir) const {
+        unsigned k = 1;
+        while (k <= (unsigned)n) {
+#if defined(__GNUC__)
+            // Pedimos por adelantado los nodos de 4 niveles mas abajo
+            __builtin_prefetch(datos.data() + k * 16);
+#endif
+            // Bajamos a la derecha si el valor del nodo no sirve (sin if)
+            k = 2 * k + (incluir ? datos[k] < x : datos[k] <= x);
+        }
+        // Deshacemos los pasos a la derecha del final: el ultimo giro
+        // a la izquierda marca la respuesta
+        k >>= countr_one(k) + 1;
+        return k;
+    }
+
+public:
+    // Congela el contenido actual del arbol
+    BSTEstatico(const BST& arbol) {
+        vector<int> ordenados;
+        for (int x : arbol)
+            ordenados.push_back(x);
+        n = ordenados.size();
+        datos.resize(n + 1);
+        int i = 0;
+        construir(ordenados, i, 1);
+    }
+
+    // Devuelve un puntero al valor x (NULL si no esta)
+    const int* buscar(int x) const {
+        int k = buscarPosicion(x, true);
+        if (k == 0 || datos[k] != x)
+            return NULL;
+        return &datos[k];
+    }
+
+    // Devuelve un puntero al menor valor mayor que x (NULL si no hay)
+    const int* sucesor(int x) const {
+        int k = buscarPosicion(x, false);
+        if (k == 0)
+            return NULL;
+        return &datos[k];
+    }
+
+    int size() const {
+        return n;
     }
 };
 
+// Compara el tiempo de "consultas" busquedas y sucesores en el BST con
+// punteros contra la copia Eytzinger, ambos con n valores
+void compararBusquedas(int n, int consultas) {
+    vector<int> valores(n);
+    for (int i = 0; i < n; i++)
+        valores[i] = 2 * i;              // solo pares: la mitad de busquedas falla
+
+    BST arbol;
+    auto t0 = chrono::steady_clock::now();
+    arbol.cargarOrdenado(valores);
+    auto t1 = chrono::steady_clock::now();
+    BSTEstatico estatico(arbol);
+    auto t2 = chrono::steady_clock::now();
+    cout << "Carga balanceada: "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms, "
+         << "copia Eytzinger: "
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms" << endl;
+
+    mt19937 gen(42);
+    uniform_int_distribution<int> dist(0, 2 * n);
+    vector<int> xs(consultas);
+    for (int& x : xs)
+        x = dist(gen);
+
+    // Sumamos los resultados para que el compilador no elimine las busquedas
+    long long suma = 0;
+    t0 = chrono::steady_clock::now();
+    for (int x : xs) {
+        Nodo* a = arbol.buscar(x);
+        Nodo* b = arbol.sucesor(a != NULL ? x : x - 1);
+        suma += (a != NULL) + (b != NULL ? b->dato : 0);
+    }
+    t1 = chrono::steady_clock::now();
+    for (int x : xs) {
+        const int* a = estatico.buscar(x);
+        const int* b = estatico.sucesor(a != NULL ? x : x - 1);
+        suma -= (a != NULL) + (b != NULL ? *b : 0);
+    }
+    t2 = chrono::steady_clock::now();
+
+    double ns_arbol = chrono::duration<double, nano>(t1 - t0).count() / consultas;
+    double ns_estatico = chrono::duration<double, nano>(t2 - t1).count() / consultas;
+    cout << "BST: " << ns_arbol << " ns/consulta, "
+         << "Eytzinger: " << ns_estatico << " ns/consulta ("
+         << ns_arbol / ns_estatico << "x)" << endl;
+    if (suma != 0)
+        cout << "Los resultados no coinciden!" << endl;
+}
+
+// BST concurrente: los lectores (buscar, minimo, maximo, sucesor) nunca
+// toman locks. Los nodos publicados no se modifican: cada escritura copia
+// el camino desde la raiz hasta el cambio y publica la nueva raiz de forma
+// atomica, asi un lector siempre ve una version completa del arbol.
+// Los nodos reemplazados se liberan por epocas: solo cuando ningun lector
+// que pudo verlos sigue activo.
+class BSTConcurrente {
+private:
+    // Nodo inmutable una vez publicado
+    struct NodoC {
+        int dato;
+        NodoC* left;
+        NodoC* right;
+        NodoC(int dato, NodoC* left, NodoC* right)
+            : dato(dato), left(left), right(right) {}
+    };
+
+    // Ranura donde cada hilo lector anuncia la epoca en la que entro
+    // (0 = fuera de una lectura). Cada una ocupa su propia linea de cache.
+    struct alignas(64) Ranura {
+        atomic<uint64_t> epoca{0};
+        atomic<bool> ocupada{false};
+    };
+
+    static constexpr int MAX_LECTORES = 128;
+    static Ranura ranuras[MAX_LECTORES];    // compartidas por todos los arboles
+    static atomic<uint64_t> epocaGlobal;
+
+    // Libera la ranura del hilo cuando este termina
+    struct RegistroLector {
+        int indice = -1;
+        ~RegistroLector() {
+            if (indice >= 0)
+                ranuras[indice].ocupada.store(false);
+        }
+    };
+
+    // Devuelve la ranura del hilo actual (la reserva la primera vez)
+    static Ranura& miRanura() {
+        thread_local RegistroLector registro;
+        if (registro.indice < 0) {
+            for (int i = 0; i < MAX_LECTORES && registro.indice < 0; i++) {
+                bool libre = false;
+                if (ranuras[i].ocupada.compare_exchange_strong(libre, true))
+                    registro.indice = i;
+            }
+            if (registro.indice < 0)
+                throw runtime_error("BSTConcurrente: demasiados hilos lectores");
+        }
+        return ranuras[registro.indice];
+    }
+
+    // Mientras existe, los nodos que el hilo puede ver no se liberan
+    class SeccionLectura {
+    private:
+        Ranura& ranura;
+
+    public:
+        SeccionLectura() : ranura(miRanura()) {
+            ranura.epoca.store(epocaGlobal.load());
+        }
+        ~SeccionLectura() {
+            ranura.epoca.store(0);
+        }
+    };
+
+    atomic<NodoC*> raiz{nullptr};
+    mutex escritura;                              // serializa a los escritores
+    vector<pair<uint64_t, NodoC*>> retirados;     // nodos a liberar y su epoca
+
+    // Copia el camino hasta donde va x y devuelve la nueva raiz del subarbol
+    NodoC* insertarAux(NodoC* nodo, int x, vector<NodoC*>& reemplazados) {
+        if (nodo == NULL)
+            return new NodoC(x, NULL, NULL);
+        reemplazados.push_back(nodo);
+        if (x < nodo->dato)
+            return new NodoC(nodo->dato, insertarAux(nodo->left, x, reemplazados), nodo->right);
+        else
+            return new NodoC(nodo->dato, nodo->left, insertarAux(nodo->right, x, reemplazados));
+    }
+
+    // Copia el camino sin el minimo del subarbol y guarda ese minimo
+    NodoC* quitarMinimo(NodoC* nodo, int& minimo, vector<NodoC*>& reemplazados) {
+        reemplazados.push_back(nodo);
+        if (nodo->left == NULL) {
+            minimo = nodo->dato;
+            return nodo->right;
+        }
+        return new NodoC(nodo->dato, quitarMinimo(nodo->left, minimo, reemplazados), nodo->right);
+    }
+
+    // Copia el camino hasta x sin x (x debe existir) y devuelve la nueva raiz
+    NodoC* eliminarAux(NodoC* nodo, int x, vector<NodoC*>& reemplazados) {
+        reemplazados.push_back(nodo);
+        if (x < nodo->dato)
+            return new NodoC(nodo->dato, eliminarAux(nodo->left, x, reemplazados), nodo->right);
+        if (x > nodo->dato)
+            return new NodoC(nodo->dato, nodo->left, eliminarAux(nodo->right, x, reemplazados));
+        // Caso 1 y 2: hoja o un solo hijo → el hijo ocupa su lugar
+        if (nodo->left == NULL)
+            return nodo->right;
+        if (nodo->right == NULL)
+            return nodo->left;
+        // Caso 3: dos hijos → un nodo nuevo con el valor del sucesor
+        int minimo;
+        NodoC* derecha = quitarMinimo(nodo->right, minimo, reemplazados);
+        return new NodoC(minimo, nodo->left, derecha);
+    }
+
+    // Publica la nueva raiz, retira los nodos viejos y libera los que ya
+    // ningun lector puede estar viendo (se llama con "escritura" tomado)
+    void publicar(NodoC* nueva, const vector<NodoC*>& reemplazados) {
+        raiz.store(nueva);
+        // Los lectores que entren desde ahora anuncian una epoca mayor y
+        // solo pueden ver la nueva raiz
+        uint64_t epoca = epocaGlobal.fetch_add(1);
+        for (NodoC* nodo : reemplazados)
+            retirados.push_back(make_pair(epoca, nodo));
+
+        // La epoca mas antigua que todavia puede tener un lector activo
+        uint64_t minima = UINT64_MAX;
+        for (int i = 0; i < MAX_LECTORES; i++) {
+            uint64_t e = ranuras[i].epoca.load();
+            if (e != 0 && e < minima)
+                minima = e;
+        }
+        int quedan = 0;
+        for (auto& par : retirados) {
+            if (par.first < minima)
+                delete par.second;
+            else
+                retirados[quedan++] = par;
+        }
+        retirados.resize(quedan);
+    }
+
+    // Busca x desde "nodo" (el llamador asegura que los nodos no se liberan)
+    static bool contiene(NodoC* nodo, int x) {
+        while (nodo != NULL) {
+            if (x == nodo->dato)
+                return true;
+            nodo = x < nodo->dato ? nodo->left : nodo->right;
+        }
+        return false;
+    }
+
+    // Elimina todos los nodos del subarbol (sin lectores activos)
+    void liberar(NodoC* nodo) {
+        if (nodo == NULL)
+            return;
+        liberar(nodo->left);
+        liberar(nodo->right);
+        delete nodo;
+    }
+
+public:
+    ~BSTConcurrente() {
+        liberar(raiz.load());
+        for (auto& par : retirados)
+            delete par.second;
+    }
+
+    // Inserta x (los lectores siguen viendo la version anterior hasta publicar)
+    void insertarNodo(int x) {
+        lock_guard<mutex> lock(escritura);
+        if (contiene(raiz.load(), x))
+            return;                          // no insertamos duplicados
+        vector<NodoC*> reemplazados;
+        NodoC* nueva = insertarAux(raiz.load(), x, reemplazados);
+        publicar(nueva, reemplazados);
+    }
+
+    // Elimina x si existe
+    void eliminar(int x) {
+        lock_guard<mutex> lock(escritura);
+        if (!contiene(raiz.load(), x))
+            return;
+        vector<NodoC*> reemplazados;
+        NodoC* nueva = eliminarAux(raiz.load(), x, reemplazados);
+        publicar(nueva, reemplazados);
+    }
+
+    // Indica si x esta en el arbol (sin locks)
+    bool buscar(int x) {
+        SeccionLectura seccion;
+        return contiene(raiz.load(), x);
+    }
+
+    // Devuelve el valor minimo del árbol (no debe estar vacio)
+    int minimo() {
+        SeccionLectura seccion;
+        NodoC* nodo = raiz.load();
+        while (nodo->left != NULL)
+            nodo = nodo->left;
+        return nodo->dato;
+    }
+
+    // Devuelve el valor maximo del árbol (no debe estar vacio)
+    int maximo() {
+        SeccionLectura seccion;
+        NodoC* nodo = raiz.load();
+        while (nodo->right != NULL)
+            nodo = nodo->right;
+        return nodo->dato;
+    }
+
+    // Guarda en "suc" el menor valor mayor que x; false si no hay
+    bool sucesor(int x, int& suc) {
+        SeccionLectura seccion;
+        NodoC* nodo = raiz.load();
+        bool encontrado = false;
+        while (nodo != NULL) {
+            if (nodo->dato > x) {
+                suc = nodo->dato;            // candidato, buscamos uno menor
+                encontrado = true;
+                nodo = nodo->left;
+            }
+            else {
+                nodo = nodo->right;
+            }
+        }
+        return encontrado;
+    }
+};
+BSTConcurrente::Ranura BSTConcurrente::ranuras[BSTConcurrente::MAX_LECTORES];
+atomic<uint64_t> BSTConcurrente::epocaGlobal{1};   // 0 se reserva para "inactivo"
+
+// Mide cuantas busquedas por segundo hacen "lectores" hilos durante
+// "milisegundos" mientras un escritor inserta y elimina sin parar.
+// Con "conMutex" usa el BST comun protegido por un mutex global.
+double medirLecturas(int n, int lectores, int milisegundos, bool conMutex) {
+    BST arbol;
+    mutex global;
+    BSTConcurrente concurrente;
+    vector<int> valores(n);
+    for (int i = 0; i < n; i++)
+        valores[i] = 2 * i;
+    arbol.cargarOrdenado(valores);
+    // Insertamos en orden aleatorio para que el arbol quede balanceado
+    shuffle(valores.begin(), valores.end(), mt19937(7));
+    for (int x : valores)
+        concurrente.insertarNodo(x);
+
+    atomic<bool> parar{false};
+    atomic<long long> total{0};
+    vector<thread> hilos;
+    for (int t = 0; t < lectores; t++) {
+        hilos.emplace_back([&, t]() {
+            mt19937 gen(t);
+            uniform_int_distribution<int> dist(0, 2 * n);
+            long long hechas = 0;
+            while (!parar.load(memory_order_relaxed)) {
+                int x = dist(gen);
+                if (conMutex) {
+                    lock_guard<mutex> lock(global);
+                    arbol.buscar(x);
+                }
+                else {
+                    concurrente.buscar(x);
+                }
+                hechas++;
+            }
+            total += hechas;
+        });
+    }
+    // El escritor agrega y quita impares (no cambian las busquedas de pares)
+    hilos.emplace_back([&]() {
+        mt19937 gen(1000);
+        uniform_int_distribution<int> dist(0, n - 1);
+        while (!parar.load(memory_order_relaxed)) {
+            int x = 2 * dist(gen) + 1;
+            if (conMutex) {
+                { lock_guard<mutex> lock(global); arbol.insertarNodo(x); }
+                { lock_guard<mutex> lock(global); arbol.eliminar(x); }
+            }
+            else {
+                concurrente.insertarNodo(x);
+                concurrente.eliminar(x);
+            }
+        }
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(milisegundos));
+    parar = true;
+    for (thread& h : hilos)
+        h.join();
+    return total * 1000.0 / milisegundos;
+}
+
+// BST generico clave/valor: MapaBST<K, V, Compare>
+// Cada valor se construye una sola vez dentro de su nodo (emplace) y nunca
+// se copia ni se mueve despues, asi V puede ser grande o solo movible.
+// En el nodo van primero los enlaces y la clave (lo que se lee al bajar por
+// el arbol) y al final el valor, que solo se toca cuando se pide.
+template<typename K, typename V, typename Compare = less<K>>
+class MapaBST {
+public:
+    struct NodoMapa {
+        NodoMapa* left = NULL;       // puntero al hijo izquierdo
+        NodoMapa* right = NULL;      // puntero al hijo derecho
+        NodoMapa* padre;             // puntero al padre (NULL en la raiz)
+        const K clave;               // clave (no cambia: define el orden)
+        V valor;                     // valor (al final: parte "fria" del nodo)
+
+        // Construye clave y valor en su lugar con los argumentos recibidos
+        template<typename KK, typename... Args>
+        NodoMapa(NodoMapa* padre, KK&& clave, Args&&... args)
+            : padre(padre), clave(std::forward<KK>(clave)),
+              valor(std::forward<Args>(args)...) {}
+    };
+
+private:
+    NodoMapa* raiz = NULL;
+    int cantidad = 0;
+    [[no_unique_address]] Compare comp;
+
+    // Devuelve el nodo con clave equivalente a "clave" (NULL si no esta)
+    template<typename Q>
+    NodoMapa* buscarNodo(const Q& clave) const {
+        NodoMapa* nodo = raiz;
+        while (nodo != NULL) {
+            if (comp(clave, nodo->clave))
+                nodo = nodo->left;
+            else if (comp(nodo->clave, clave))
+                nodo = nodo->right;
+            else
+                return nodo;
+        }
+        return NULL;
+    }
+
+    static NodoMapa* minimoNodo(NodoMapa* nodo) {
+        while (nodo->left != NULL)
+            nodo = nodo->left;
+        return nodo;
+    }
+
+    static NodoMapa* maximoNodo(NodoMapa* nodo) {
+        while (nodo->right != NULL)
+            nodo = nodo->right;
+        return nodo;
+    }
+
+    // Sucesor en orden usando los punteros al padre
+    static NodoMapa* sucesorNodo(NodoMapa* nodo) {
+        if (nodo->right != NULL)
+            return minimoNodo(nodo->right);
+        NodoMapa* padre = nodo->padre;
+        while (padre != NULL && nodo == padre->right) {
+            nodo = padre;
+            padre = padre->padre;
+        }
+        return padre;
+    }
+
+    // Pone el subarbol "hijo" en el lugar de "nodo" dentro de su padre
+    void reemplazarEnPadre(NodoMapa* nodo, NodoMapa* hijo) {
+        if (hijo != NULL)
+            hijo->padre = nodo->padre;
+        if (nodo->padre == NULL)
+            raiz = hijo;
+        else if (nodo->padre->left == nodo)
+            nodo->padre->left = hijo;
+        else
+            nodo->padre->right = hijo;
+    }
+
+    void liberar(NodoMapa* nodo) {
+        if (nodo == NULL)
+            return;
+        liberar(nodo->left);
+        liberar(nodo->right);
+        delete nodo;
+    }
+
+public:
+    // Iterador en orden: *it es el nodo (it->clave, it->valor)
+    class Iterador {
+    private:
+        NodoMapa* actual;
+
+    public:
+        Iterador(NodoMapa* actual) : actual(actual) {}
+
+        NodoMapa& operator*() const { return *actual; }
+        NodoMapa* operator->() const { return actual; }
+
+        Iterador& operator++() {
+            actual = sucesorNodo(actual);
+            return *this;
+        }
+
+        bool operator==(const Iterador& otro) const { return actual == otro.actual; }
+        bool operator!=(const Iterador& otro) const { return actual != otro.actual; }
+    };
+
+    MapaBST() = default;
+    MapaBST(const MapaBST&) = delete;             // los valores no se copian
+    MapaBST& operator=(const MapaBST&) = delete;
+
+    ~MapaBST() {
+        liberar(raiz);
+    }
+
+    Iterador begin() const {
+        return Iterador(raiz == NULL ? NULL : minimoNodo(raiz));
+    }
+
+    Iterador end() const {
+        return Iterador(NULL);
+    }
+
+    // Si "clave" no esta, crea su nodo construyendo el valor en su lugar con
+    // "args". Devuelve el valor guardado y si se inserto (los args no se usan
+    // cuando la clave ya existia).
+    template<typename... Args>
+    pair<V*, bool> emplace(K clave, Args&&... args) {
+        NodoMapa* padre = NULL;
+        NodoMapa** lugar = &raiz;
+        while (*lugar != NULL) {
+            padre = *lugar;
+            if (comp(clave, padre->clave))
+                lugar = &padre->left;
+            else if (comp(padre->clave, clave))
+                lugar = &padre->right;
+            else
+                return make_pair(&padre->valor, false);   // no hay duplicados
+        }
+        *lugar = new NodoMapa(padre, std::move(clave), std::forward<Args>(args)...);
+        cantidad++;
+        return make_pair(&(*lugar)->valor, true);
+    }
+
+    // Inserta moviendo un valor ya construido
+    pair<V*, bool> insertar(K clave, V&& valor) {
+        return emplace(std::move(clave), std::move(valor));
+    }
+
+    // Devuelve el valor de "clave" (NULL si no esta). Con un Compare
+    // transparente (como less<>) acepta cualquier tipo comparable con K,
+    // por ejemplo string_view para claves string, sin crear una K temporal
+    template<typename Q>
+        requires requires { typename Compare::is_transparent; }
+    V* buscar(const Q& clave) {
+        NodoMapa* nodo = buscarNodo(clave);
+        return nodo == NULL ? NULL : &nodo->valor;
+    }
+
+    V* buscar(const K& clave) {
+        NodoMapa* nodo = buscarNodo(clave);
+        return nodo == NULL ? NULL : &nodo->valor;
+    }
+
+    // Elimina la entrada de "clave" si existe
+    template<typename Q>
+        requires requires { typename Compare::is_transparent; }
+    void eliminar(const Q& clave) {
+        NodoMapa* nodo = buscarNodo(clave);
+        if (nodo != NULL)
+            eliminarNodo(nodo);
+    }
+
+    void eliminar(const K& clave) {
+        NodoMapa* nodo = buscarNodo(clave);
+        if (nodo != NULL)
+            eliminarNodo(nodo);
+    }
+
+    int size() const {
+        return cantidad;
+    }
+
+private:
+    // Desenlaza y libera el nodo. Con dos hijos el sucesor toma su lugar
+    // (se reenlaza, no se copia su valor).
+    void eliminarNodo(NodoMapa* nodo) {
+        if (nodo->left == NULL) {
+            reemplazarEnPadre(nodo, nodo->right);
+        }
+        else if (nodo->right == NULL) {
+            reemplazarEnPadre(nodo, nodo->left);
+        }
+        else {
+            NodoMapa* suc = minimoNodo(nodo->right);
+            if (suc->padre != nodo) {
+                // Sacamos al sucesor de su lugar y le damos el subarbol derecho
+                reemplazarEnPadre(suc, suc->right);
+                suc->right = nodo->right;
+                suc->right->padre = suc;
+            }
+            reemplazarEnPadre(nodo, suc);
+            suc->left = nodo->left;
+            suc->left->padre = suc;
+        }
+        delete nodo;
+        cantidad--;
+    }
+};
+
+// Registro de 1 KB que cuenta cuantas veces se copia o se mueve
+struct Registro {
+    static inline long long copias = 0;
+    static inline long long movimientos = 0;
+    char datos[1024];
+
+    Registro(char relleno) {
+        memset(datos, relleno, sizeof(datos));
+    }
+    Registro(const Registro& otro) {
+        memcpy(datos, otro.datos, sizeof(datos));
+        copias++;
+    }
+    Registro(Registro&& otro) noexcept {
+        memcpy(datos, otro.datos, sizeof(datos));
+        movimientos++;
+    }
+};
+
+// Inserta n registros de 1 KB con emplace y muestra el tiempo y cuantas
+// copias o movimientos de registros hubo (deberian ser 0)
+void medirInsercionRegistros(int n) {
+    MapaBST<string, Registro, less<>> mapa;
+    vector<int> ids(n);
+    for (int i = 0; i < n; i++)
+        ids[i] = i;
+    shuffle(ids.begin(), ids.end(), mt19937(5));
+
+    Registro::copias = Registro::movimientos = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int id : ids)
+        mapa.emplace("registro" + to_string(id), (char)('a' + id % 26));
+    auto t1 = chrono::steady_clock::now();
+
+    cout << n << " registros de 1 KB en "
+         << chrono::duration<double, milli>(t1 - t0).count() << " ms, copias: "
+         << Registro::copias << ", movimientos: " << Registro::movimientos << endl;
+}
+
 int main() {
     BST arbol;
 
@@ -289,6 +1138,21 @@ int main() {
     cout << "Maximo: " << arbol.maximo() << endl;
     Nodo* suc = arbol.sucesor(5);
     if (suc) cout << "Sucesor de 5: " << suc->dato << endl;
+    Nodo* pred = arbol.predecesor(5);
+    if (pred) cout << "Predecesor de 5: " << pred->dato << endl;
+    */
+
+    /*
+    // Ejemplo de recorrido con el iterador (hacia adelante y hacia atras)
+    for (BST::Iterador it = arbol.begin(); it != arbol.end(); ++it)
+        cout << *it << ' ';
+    cout << endl;
+    BST::Iterador it = arbol.end();
+    while (it != arbol.begin()) {
+        --it;
+        cout << *it << ' ';
+    }
+    cout << endl;
     */
 
     /*
@@ -299,5 +1163,45 @@ int main() {
     arbol.imprimirPostOrder();
     */
 
+    /*
+    // Ejemplos de consultas por rango y estadisticos de orden
+    for (int x : arbol.rango(4, 7))
+        cout << x << ' ';                                   // 4 5 6 7
+    cout << endl;
+    cout << "3er menor: " << arbol.k_esimo(3)->dato << endl; // 5
+    cout << "rank(6): " << arbol.rank(6) << endl;            // 2 (4 y 5)
+    cout << "En [5,8]: " << arbol.contar_en_rango(5, 8) << endl; // 4
+    */
+
+    /*
+    // Ejemplo de carga masiva y comparacion con la copia Eytzinger
+    compararBusquedas(1 << 22, 5000000);
+    */
+
+    /*
+    // Ejemplo de lecturas concurrentes: busquedas por segundo segun la
+    // cantidad de hilos lectores, con un escritor activo todo el tiempo
+    for (int lectores = 1; lectores <= 32; lectores *= 2) {
+        cout << lectores << " lectores: "
+             << "mutex " << medirLecturas(1 << 20, lectores, 500, true)
+             << " busq/s, sin locks " << medirLecturas(1 << 20, lectores, 500, false)
+             << " busq/s" << endl;
+    }
+    */
+
+    /*
+    // Ejemplo de MapaBST con valores solo movibles y busqueda con string_view
+    MapaBST<string, unique_ptr<string>, less<>> mapa;
+    mapa.emplace("uno", make_unique<string>("primero"));
+    mapa.insertar("dos", make_unique<string>("segundo"));
+    string_view clave = "uno";
+    if (unique_ptr<string>* valor = mapa.buscar(clave))
+        cout << clave << " -> " << **valor << endl;
+    mapa.eliminar("uno");
+    for (auto& entrada : mapa)
+        cout << entrada.clave << ": " << *entrada.valor << endl;
+    medirInsercionRegistros(200000);
+    */
+
     return 0;
 }
@@ -0,0 +1,400 @@
+// ARBOL BINARIO DE BUSQUEDA EN DISCO
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>       // para medir el tiempo de reapertura
+#include <cstdint>      // para uint64_t
+#include <cstring>      // para strerror
+#include <cerrno>       // para errno
+#include <cstddef>      // para offsetof
+#include <stdexcept>    // para runtime_error
+#include <fcntl.h>      // open
+#include <unistd.h>     // close, ftruncate
+#include <sys/mman.h>   // mmap, msync, munmap
+#include <sys/stat.h>   // fstat
+using namespace std;
+
+// BST guardado en un archivo mapeado en memoria (solo POSIX).
+// El archivo se divide en paginas de 4 KB: la pagina 0 guarda la cabecera y
+// las demas guardan nodos de tamaño fijo. Los nodos escritos nunca se
+// modifican: cada cambio agrega al final copias de los nodos del camino
+// (como en BSTConcurrente de clase_1) y despues confirma la nueva raiz en la
+// cabecera. Si el programa se cae a mitad de un cambio, al reabrir se usa
+// la ultima cabecera valida y los nodos sin confirmar se ignoran.
+// El espacio de los nodos reemplazados no se recupera.
+class BSTEnDisco {
+private:
+    static const uint64_t MAGIA = 0x3130534944545342ULL;   // "BSTDIS01"
+    static const size_t TAM_PAGINA = 4096;
+
+    // Nodo en disco: los hijos son indices de nodo (0 = NULL)
+    struct NodoDisco {
+        int dato;
+        uint32_t reservado;
+        uint64_t left;
+        uint64_t right;
+    };
+    static const uint64_t NODOS_POR_PAGINA = TAM_PAGINA / sizeof(NodoDisco);
+
+    // Estado confirmado del arbol. Hay dos copias en la pagina 0 y se
+    // escriben alternadas: si una queda a medias, la otra sigue siendo valida
+    struct Cabecera {
+        uint64_t magia;
+        uint64_t secuencia;   // la copia valida con mayor secuencia es la actual
+        uint64_t raiz;        // indice del nodo raiz (0 = arbol vacio)
+        uint64_t nodos;       // cantidad de nodos escritos y confirmados
+        uint64_t cantidad;    // cantidad de valores en el arbol
+        uint64_t suma;        // suma de control de los campos anteriores
+    };
+
+    int fd = -1;              // archivo abierto
+    char* mapa = NULL;        // archivo mapeado en memoria
+    size_t tamMapa = 0;       // tamaño del archivo (y del mapeo)
+    size_t tamEnDisco = 0;    // tamaño del archivo ya llevado a disco con fsync
+    Cabecera actual;          // ultima cabecera confirmada
+    uint64_t nodos;           // nodos escritos (confirmados o no)
+
+    static uint64_t calcularSuma(const Cabecera& c) {
+        // FNV-1a sobre los campos anteriores a "suma"
+        const unsigned char* bytes = (const unsigned char*)&c;
+        uint64_t h = 1469598103934665603ULL;
+        for (size_t i = 0; i < offsetof(Cabecera, suma); i++) {
+            h ^= bytes[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    static void error(const string& mensaje) {
+        throw runtime_error("BSTEnDisco: " + mensaje + ": " + strerror(errno));
+    }
+
+    Cabecera* cabecera(int copia) {
+        return (Cabecera*)(mapa + copia * 64);
+    }
+
+    // Devuelve el nodo con indice i (i >= 1). La referencia deja de valer
+    // si el archivo crece, por eso se copian los campos antes de crear nodos
+    NodoDisco& nodo(uint64_t i) {
+        uint64_t pagina = 1 + (i - 1) / NODOS_POR_PAGINA;
+        uint64_t posicion = (i - 1) % NODOS_POR_PAGINA;
+        return *(NodoDisco*)(mapa + pagina * TAM_PAGINA + posicion * sizeof(NodoDisco));
+    }
+
+    // Vuelve a mapear el archivo, que ahora mide "tam" bytes
+    void mapear(size_t tam) {
+        if (mapa != NULL)
+            munmap(mapa, tamMapa);            // deshacemos el mapeo anterior
+        mapa = NULL;
+        tamMapa = tam;
+        void* p = mmap(NULL, tamMapa, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED)
+            error("mmap");
+        mapa = (char*)p;
+    }
+
+    // Bytes que ocupa un archivo con "total" nodos (cabecera incluida)
+    static uint64_t bytesPara(uint64_t total) {
+        return (1 + (total + NODOS_POR_PAGINA - 1) / NODOS_POR_PAGINA) * TAM_PAGINA;
+    }
+
+    // Una cabecera sirve si no esta rota y todo lo que nombra entra en el
+    // archivo (si el crecimiento no llego a disco, los nodos no estan)
+    static bool cabeceraValida(const Cabecera& c, size_t tam) {
+        return c.magia == MAGIA && c.suma == calcularSuma(c)
+            && c.nodos <= (tam / TAM_PAGINA) * NODOS_POR_PAGINA
+            && bytesPara(c.nodos) <= tam
+            && c.raiz <= c.nodos && c.cantidad <= c.nodos;
+    }
+
+    // Asegura que el archivo tenga lugar para "total" nodos (crece al doble)
+    void asegurarEspacio(uint64_t total) {
+        size_t necesario = bytesPara(total);
+        if (necesario <= tamMapa)
+            return;
+        size_t nuevo = max(necesario, 2 * tamMapa);
+        if (ftruncate(fd, nuevo) != 0)
+            error("ftruncate");
+        mapear(nuevo);
+    }
+
+    // Agrega un nodo al final del archivo y devuelve su indice
+    uint64_t nuevoNodo(int dato, uint64_t left, uint64_t right) {
+        asegurarEspacio(nodos + 1);
+        nodos++;
+        NodoDisco& n = nodo(nodos);
+        n.dato = dato;
+        n.reservado = 0;
+        n.left = left;
+        n.right = right;
+        return nodos;
+    }
+
+    // Lleva a disco las paginas con [desde, hasta) bytes del mapeo
+    void sincronizar(size_t desde, size_t hasta) {
+        desde -= desde % TAM_PAGINA;              // msync pide direccion alineada
+        if (hasta > desde && msync(mapa + desde, hasta - desde, MS_SYNC) != 0)
+            error("msync");
+    }
+
+    // Confirma un cambio: primero guarda los nodos nuevos y despues la
+    // cabecera en la copia que no es la actual
+    void confirmar(uint64_t raiz, uint64_t cantidad) {
+        if (nodos > actual.nodos) {
+            uint64_t primero = actual.nodos + 1;
+            size_t desde = (1 + (primero - 1) / NODOS_POR_PAGINA) * TAM_PAGINA;
+            size_t hasta = (1 + (nodos - 1) / NODOS_POR_PAGINA + 1) * TAM_PAGINA;
+            sincronizar(desde, hasta);
+        }
+        // msync no garantiza el nuevo tamaño del archivo: si crecio, fsync
+        // antes de que la cabecera apunte a nodos de la parte nueva
+        if (tamMapa > tamEnDisco) {
+            if (fsync(fd) != 0)
+                error("fsync");
+            tamEnDisco = tamMapa;
+        }
+        Cabecera nueva;
+        nueva.magia = MAGIA;
+        nueva.secuencia = actual.secuencia + 1;
+        nueva.raiz = raiz;
+        nueva.nodos = nodos;
+        nueva.cantidad = cantidad;
+        nueva.suma = calcularSuma(nueva);
+        *cabecera(nueva.secuencia % 2) = nueva;
+        sincronizar(0, TAM_PAGINA);
+        actual = nueva;
+    }
+
+    // Copia el camino hasta donde va x y devuelve la nueva raiz del subarbol
+    uint64_t insertarAux(uint64_t i, int x) {
+        if (i == 0)
+            return nuevoNodo(x, 0, 0);
+        NodoDisco n = nodo(i);                    // copia: el mapeo puede cambiar
+        if (x < n.dato)
+            return nuevoNodo(n.dato, insertarAux(n.left, x), n.right);
+        else
+            return nuevoNodo(n.dato, n.left, insertarAux(n.right, x));
+    }
+
+    // Copia el camino sin el minimo del subarbol y guarda ese minimo
+    uint64_t quitarMinimo(uint64_t i, int& minimo) {
+        NodoDisco n = nodo(i);
+        if (n.left == 0) {
+            minimo = n.dato;
+            return n.right;
+        }
+        return nuevoNodo(n.dato, quitarMinimo(n.left, minimo), n.right);
+    }
+
+    // Copia el camino hasta x sin x (x debe existir) y devuelve la nueva raiz
+    uint64_t eliminarAux(uint64_t i, int x) {
+        NodoDisco n = nodo(i);
+        if (x < n.dato)
+            return nuevoNodo(n.dato, eliminarAux(n.left, x), n.right);
+        if (x > n.dato)
+            return nuevoNodo(n.dato, n.left, eliminarAux(n.right, x));
+        // Caso 1 y 2: hoja o un solo hijo → el hijo ocupa su lugar
+        if (n.left == 0)
+            return n.right;
+        if (n.right == 0)
+            return n.left;
+        // Caso 3: dos hijos → un nodo nuevo con el valor del sucesor
+        int minimo;
+        uint64_t derecha = quitarMinimo(n.right, minimo);
+        return nuevoNodo(minimo, n.left, derecha);
+    }
+
+    // Escribe un subarbol balanceado con valores[ini, fin) (hijos primero)
+    uint64_t construirBalanceado(const vector<int>& valores, int ini, int fin) {
+        if (ini >= fin)
+            return 0;
+        int medio = ini + (fin - ini) / 2;
+        uint64_t left = construirBalanceado(valores, ini, medio);
+        uint64_t right = construirBalanceado(valores, medio + 1, fin);
+        return nuevoNodo(valores[medio], left, right);
+    }
+
+public:
+    // Abre el indice guardado en "ruta" o lo crea vacio si no existe
+    BSTEnDisco(const string& ruta) {
+        fd = open(ruta.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0)
+            error("open " + ruta);
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+            error("fstat");
+        size_t tam = info.st_size;
+        tamEnDisco = tam;                         // lo que ya estaba en el archivo
+        if (tam < TAM_PAGINA) {
+            // Archivo nuevo: solo la pagina de cabecera
+            tam = TAM_PAGINA;
+            if (ftruncate(fd, tam) != 0)
+                error("ftruncate");
+        }
+        mapear(tam);
+
+        // Elegimos la copia valida de la cabecera con mayor secuencia; si
+        // una nombra nodos fuera del archivo se usa la otra
+        actual = Cabecera{MAGIA, 0, 0, 0, 0, 0};
+        for (int copia = 0; copia < 2; copia++) {
+            Cabecera c = *cabecera(copia);
+            if (cabeceraValida(c, tam) && c.secuencia > actual.secuencia)
+                actual = c;
+        }
+        // Los nodos escritos despues de la ultima confirmacion se descartan
+        nodos = actual.nodos;
+    }
+
+    BSTEnDisco(const BSTEnDisco&) = delete;
+    BSTEnDisco& operator=(const BSTEnDisco&) = delete;
+
+    ~BSTEnDisco() {
+        if (mapa != NULL)
+            munmap(mapa, tamMapa);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    // Inserta un valor x en el arbol (y lo confirma en disco)
+    void insertarNodo(int x) {
+        if (buscar(x))
+            return;                               // no insertamos duplicados
+        uint64_t raiz = insertarAux(actual.raiz, x);
+        confirmar(raiz, actual.cantidad + 1);
+    }
+
+    // Elimina el valor x si existe (y lo confirma en disco)
+    void eliminar(int x) {
+        if (!buscar(x))
+            return;
+        uint64_t raiz = eliminarAux(actual.raiz, x);
+        confirmar(raiz, actual.cantidad - 1);
+    }
+
+    // Reemplaza el contenido por "valores" (ordenados y sin repetidos)
+    // con un arbol balanceado escrito en O(n) y una sola confirmacion
+    void cargarOrdenado(const vector<int>& valores) {
+        for (size_t i = 1; i < valores.size(); i++) {
+            if (valores[i - 1] >= valores[i])
+                throw invalid_argument("cargarOrdenado: valores no ordenados o repetidos");
+        }
+        asegurarEspacio(nodos + valores.size());
+        uint64_t raiz = construirBalanceado(valores, 0, valores.size());
+        confirmar(raiz, valores.size());
+    }
+
+    // Indica si x esta en el arbol
+    bool buscar(int x) {
+        uint64_t i = actual.raiz;
+        while (i != 0) {
+            NodoDisco& n = nodo(i);
+            if (x == n.dato)
+                return true;
+            i = x < n.dato ? n.left : n.right;
+        }
+        return false;
+    }
+
+    // Guarda en "suc" el menor valor mayor que x; false si no hay
+    bool sucesor(int x, int& suc) {
+        uint64_t i = actual.raiz;
+        bool encontrado = false;
+        while (i != 0) {
+            NodoDisco& n = nodo(i);
+            if (n.dato > x) {
+                suc = n.dato;                     // candidato, buscamos uno menor
+                encontrado = true;
+                i = n.left;
+            }
+            else {
+                i = n.right;
+            }
+        }
+        return encontrado;
+    }
+
+    // Devuelve el valor minimo del árbol (no debe estar vacio)
+    int minimo() {
+        uint64_t i = actual.raiz;
+        while (nodo(i).left != 0)
+            i = nodo(i).left;
+        return nodo(i).dato;
+    }
+
+    // Devuelve el valor maximo del árbol (no debe estar vacio)
+    int maximo() {
+        uint64_t i = actual.raiz;
+        while (nodo(i).right != 0)
+            i = nodo(i).right;
+        return nodo(i).dato;
+    }
+
+    // Devuelve la cantidad de valores en el arbol
+    uint64_t size() {
+        return actual.cantidad;
+    }
+};
+
+// Crea en "ruta" un indice con n valores, lo cierra y mide cuanto tarda en
+// reabrirlo y responder la primera consulta
+void medirReapertura(const string& ruta, int n) {
+    unlink(ruta.c_str());
+    {
+        vector<int> valores(n);
+        for (int i = 0; i < n; i++)
+            valores[i] = 2 * i;
+        auto t0 = chrono::steady_clock::now();
+        BSTEnDisco indice(ruta);
+        indice.cargarOrdenado(valores);
+        auto t1 = chrono::steady_clock::now();
+        cout << "Construccion de " << n << " valores: "
+             << chrono::duration<double, milli>(t1 - t0).count() << " ms" << endl;
+    }
+
+    auto t0 = chrono::steady_clock::now();
+    BSTEnDisco indice(ruta);
+    // Solo se cargaron claves pares (0, 2, ..., 2n - 2): buscar(n) tiene
+    // que dar true exactamente cuando n es par
+    bool esta = indice.buscar(n);
+    auto t1 = chrono::steady_clock::now();
+    cout << "Reapertura + primera consulta: "
+         << chrono::duration<double, micro>(t1 - t0).count() << " us"
+         << " (buscar(" << n << ") = " << esta << ")" << endl;
+}
+
+int main() {
+    try {
+        // Primera ejecucion: creamos el indice e insertamos valores
+        {
+            BSTEnDisco arbol("indice_bst.dat");
+            arbol.insertarNodo(5);
+            arbol.insertarNodo(7);
+            arbol.insertarNodo(4);
+            arbol.insertarNodo(6);
+            arbol.insertarNodo(8);
+            arbol.insertarNodo(2);
+            arbol.eliminar(4);
+        }
+
+        // Al reabrir el archivo el arbol sigue ahi
+        BSTEnDisco arbol("indice_bst.dat");
+        cout << "Cantidad: " << arbol.size() << endl;
+        cout << "Minimo: " << arbol.minimo() << ", Maximo: " << arbol.maximo() << endl;
+        int suc = 0;
+        if (arbol.sucesor(5, suc))
+            cout << "Sucesor de 5: " << suc << endl;
+        cout << "Esta el 4? " << (arbol.buscar(4) ? "si" : "no") << endl;
+    }
+    catch (const std::exception& e) {
+        cerr << e.what() << endl;
+    }
+    unlink("indice_bst.dat");
+
+    /*
+    // Ejemplo de reapertura de un indice grande (10^8 valores, ~2.4 GB)
+    medirReapertura("indice_grande.dat", 100000000);
+    */
+
+    return 0;
+}